@@ -1,16 +1,22 @@
 #ifndef INCLUDE_AI_MANAGER_HPP_
 #define INCLUDE_AI_MANAGER_HPP_
 
+#include <algorithm>
 #include <map>
 #include <queue>
 #include <random>
+#include "job_system.hpp"
 #include "map.hpp"
+#include "random_stream.hpp"
 
 namespace villa
 {
 	/**
 	 * AI Manager class.
 	 * Handles all villager behaviour and decision-making.
+	 * Villagers decide in parallel against the state of the map at the start of the tick. Actions that change
+	 * other entities are deferred and resolved one villager at a time in a fixed order, so the result does not
+	 * depend on the number of threads.
 	 */
 	class ai_manager
 	{
@@ -38,26 +44,32 @@ namespace villa
 		};
 
 		public:
-			ai_manager(map* simulation_map, std::mt19937& rng);
-			void think();
-			double get_timescale();
-			void set_timescale(double value);
+			ai_manager(map* simulation_map, job_system* jobs, unsigned int seed);
+			void think(unsigned long tick);
 
 		private:
+			static const std::size_t DECISION_GRAIN = 8;
+			static const std::size_t DECISION_JOBS_PER_THREAD = 4;
 			map* simulation_map;
-			std::mt19937& rng;
-			double timescale;
+			job_system* jobs;
+			unsigned int seed;
+			unsigned long tick;
+			std::vector<unsigned char> resolutions;
+			bool decide(villager* value);
+			void resolve(villager* value);
 			void handle_task_idle(villager* value);
 			void handle_task_move(villager* value);
-			void handle_task_build(villager* value);
+			bool handle_task_build(villager* value);
+			void handle_task_build_complete(villager* value);
 			void handle_task_harvest(villager* value);
 			void handle_task_take_item(villager* value);
 			void handle_task_store_item(villager* value);
 			void handle_task_rest(villager* value);
 			bool handle_villager_needs(villager* value);
 			std::pair<building*, item*> get_item_in_building(int x, int y, itemtype type);
-			resource* get_closest_resource(int x, int y, resourcetype type);
+			resource* get_closest_resource(int x, int y, resourcetype type, random_stream& rng);
 			std::vector<std::pair<int, int>> get_path(int x, int y, int target_x, int target_y);
+			random_stream get_random_stream(villager* value, randompurpose purpose);
 	};
 }
 
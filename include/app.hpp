@@ -1,16 +1,20 @@
 #ifndef INCLUDE_APP_H_
 #define INCLUDE_APP_H_
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <random>
 #include <sstream>
 #include <stack>
+#include <thread>
 #include <time.h>
-#include "ai_manager.hpp"
-#include "map.hpp"
+#include "camera.hpp"
 #include "resource_manager.hpp"
+#include "simulation_runner.hpp"
 #include "ui_manager.hpp"
 #include <SDL.h>
 #include <SDL_image.h>
@@ -28,19 +32,103 @@ namespace villa
 		exit
 	};
 
+	/**
+	 * Application option struct.
+	 * Set from the command line.
+	 */
+	struct option_struct
+	{
+		unsigned int frame_cap; //!< Maximum frames per second (0 for no limit)
+		bool vsync;             //!< Synchronise presentation with the display refresh
+		bool fixed_seed;        //!< Use the seed below instead of the current time
+		unsigned int seed;      //!< Seed for each simulation when fixed_seed is set
+		unsigned int threads;   //!< Number of threads to run each simulation on
+	};
+
 	/**
 	 * Application timer struct.
 	 */
 	struct timer_struct
 	{
 		unsigned int app;
-		unsigned int simulation_time;
 		unsigned int simulation_start;
 		unsigned int simulation_end;
-		unsigned int villager_health;
-		unsigned int villager_health_regen;
-		unsigned int villager_needs;
+		unsigned int tick_report;
+		unsigned long tick_report_count;
+		double tick_rate;
+		unsigned int usage_report;
+		double usage_cpu;
+		unsigned int frames;
 		double timescale;
+		bool fast_forward;
+	};
+
+	/**
+	 * Application HUD struct.
+	 * The changing text of the simulation HUD, formatted again only when its values change.
+	 */
+	struct hud_struct
+	{
+		bool dirty;                 //!< Format all of the text on the next frame
+		unsigned int refresh;       //!< Time the counters were last refreshed
+		unsigned int seconds;       //!< Simulation time shown on the clock, in seconds
+		int tick_rate;              //!< Tick rate shown in fast-forward mode
+		std::string clock;          //!< Simulation time text
+		std::string tick_rate_text; //!< Tick rate text
+		std::string counters[7];    //!< Villager, building, food, tree, stone, ore and grave counter text
+	};
+
+	/**
+	 * Tileset struct.
+	 * The texture handles of a tile type for each edge and corner.
+	 */
+	struct tileset_struct
+	{
+		texture_handle variants[tile::variant_count]; //!< The texture of each tile variant
+	};
+
+	/**
+	 * Application texture struct.
+	 * The texture handles, resolved once when the textures are loaded.
+	 */
+	struct texture_struct
+	{
+		texture_handle background, grass_c;
+		tileset_struct water, dirt, sand, stone;
+		texture_handle door_small, door_small_alt, roof_small_front, roof_small_back, wall_small_base;
+		texture_handle door_large1, door_large2;
+		texture_handle roof_large_front1, roof_large_front2, roof_large_front1_alt, roof_large_front2_alt;
+		texture_handle roof_large_middle1, roof_large_middle2;
+		texture_handle roof_large_back1, roof_large_back2, roof_large_back1_alt, roof_large_back2_alt;
+		texture_handle wall_large_middle1, wall_large_middle2, wall_large_base1, wall_large_base2;
+		texture_handle blacksmith_forge, roof_flat_back1, roof_flat_back2;
+		texture_handle stall_roof1, stall_roof2, stall_roof1_alt, stall_roof2_alt;
+		texture_handle stall_base1, stall_base2, stall_base1_alt, stall_base2_alt;
+		texture_handle food_1, food_2, food_3, food_harvested;
+		texture_handle ore_1, ore_2, ore_3, ore_4, ore_5, ore_6;
+		texture_handle stone_1, stone_2, stone_3, stone_4, stone_5, stone_6;
+		texture_handle tree_small, tree_small_harvested;
+		texture_handle tree_top, tree_top_alt, tree_top_harvested;
+		texture_handle tree_bottom, tree_bottom_alt, tree_bottom_harvested;
+		texture_handle grave_1, grave_2, grave_3;
+		texture_handle villager, villager_alt, villager_alt2, villager_alt3;
+		texture_handle cursor, iconMenu_brown, iconCross_brown, arrowBeige_left, arrowBeige_right;
+		texture_handle buttonRound_brown, buttonLong_brown, buttonLong_brown_pressed, menuBar_brown;
+		texture_handle label_building, label_food, label_grave, label_ore, label_stone, label_tree, label_villager;
+		texture_handle town_hall, house, house_small, farmhouse, blacksmith, stall[4]; //!< Buildings composed from their parts
+		texture_handle tree_large, tree_large_alt, tree_large_harvested;               //!< Trees composed from their parts
+	};
+
+	/**
+	 * Application font struct.
+	 * The font handles, resolved once when the fonts are loaded.
+	 */
+	struct font_struct
+	{
+		font_handle blocks;        //!< KenPixel Blocks (160)
+		font_handle square;        //!< KenPixel Square (24)
+		font_handle square_medium; //!< KenPixel Square Medium (20)
+		font_handle square_small;  //!< KenPixel Square Small (14)
 	};
 
 	/**
@@ -50,27 +138,51 @@ namespace villa
 	class app
 	{
 		public:
-			app();
+			app(option_struct options);
 			~app();
 			void start();
 
 		private:
 			bool init();
 			void load_resources();
+			void load_tileset(tileset_struct& tileset, std::string name);
+			void compose_resources();
 			void load_ui();
 			void handle_input();
 			void update_simulation();
+			static void print_entity_at(simulation* target, double x, double y);
+			void update_tick_rate();
+			void update_usage();
+			static double get_cpu_time();
+			void print_job_stats();
+			void wait_for_frame(unsigned int frame_start);
 			void update_display();
 			void display_menu_main();
 			void display_simulation();
-			void display_simulation_tile(int x, int y, tiletype type, std::string name);
-			std::mt19937 rng;
+			void update_hud(unsigned int simulation_time);
+			void display_simulation_terrain();
+			bool bake_simulation_terrain();
+			void display_simulation_terrain_tile(int x, int y, int origin_x, int origin_y);
+			void display_simulation_tile(int x, int y, int origin_x, int origin_y, const tileset_struct& tileset);
+			void destroy_simulation_terrain();
+			static const int TERRAIN_CHUNK_TILES = 32;
+			static const int TERRAIN_CHUNKS = (50 + TERRAIN_CHUNK_TILES - 1) / TERRAIN_CHUNK_TILES;
+			option_struct options;
 			timer_struct timers;
+			texture_struct textures;
+			font_struct fonts;
+			hud_struct hud;
+			// The part of the map shown on screen
+			camera simulation_camera;
+			bool display_dirty;
+			// Terrain baked into render target textures, one per chunk of tiles
+			SDL_Texture* terrain_chunks[TERRAIN_CHUNKS][TERRAIN_CHUNKS];
+			bool terrain_dirty;
+			unsigned long terrain_version;
 			std::stack<appstate> state;
 			std::unique_ptr<resource_manager> resources;
 			std::unique_ptr<ui_manager> user_interface;
-			std::unique_ptr<map> simulation_map;
-			std::unique_ptr<ai_manager> simulation_ai;
+			std::unique_ptr<simulation_runner> simulation_state;
 			SDL_Window* window;
 			SDL_Renderer* renderer;
 			SDL_Event event;
@@ -0,0 +1,41 @@
+#ifndef INCLUDE_ATLAS_PACKER_H_
+#define INCLUDE_ATLAS_PACKER_H_
+
+#include <vector>
+
+namespace villa
+{
+	/**
+	 * Atlas Packer class.
+	 * Places rectangles on a page of fixed size using shelves: rows as tall as their tallest rectangle,
+	 * filled from left to right. Rectangles packed in order of decreasing height waste the least space.
+	 */
+	class atlas_packer
+	{
+		public:
+			atlas_packer(int width, int height, int padding);
+			bool insert(int width, int height, int& x, int& y);
+			int get_width();
+			int get_height();
+			int get_used_height();
+
+		private:
+			/**
+			 * Shelf struct.
+			 * A row of rectangles on the page.
+			 */
+			struct shelf
+			{
+				int y;      //!< Top edge of the shelf
+				int height; //!< Height of the tallest rectangle on the shelf
+				int used;   //!< Width taken up by the rectangles on the shelf
+			};
+
+			int width;
+			int height;
+			int padding;
+			std::vector<shelf> shelves;
+	};
+}
+
+#endif /* INCLUDE_ATLAS_PACKER_H_ */
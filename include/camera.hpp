@@ -0,0 +1,44 @@
+#ifndef INCLUDE_CAMERA_H_
+#define INCLUDE_CAMERA_H_
+
+#include <algorithm>
+#include <cmath>
+
+namespace villa
+{
+	/**
+	 * Camera class.
+	 * The part of the world shown on screen, which can be panned and zoomed.
+	 * Transforms between world coords (pixels of the map) and screen coords.
+	 */
+	class camera
+	{
+		public:
+			static constexpr double MAX_ZOOM = 4.0;
+			camera(int view_width, int view_height, int world_width, int world_height);
+			void reset();
+			void pan(double x, double y);
+			void zoom_at(double factor, int screen_x, int screen_y);
+			double get_x();
+			double get_y();
+			double get_zoom();
+			int to_screen_x(double x);
+			int to_screen_y(double y);
+			double to_world_x(int x);
+			double to_world_y(int y);
+			bool is_visible(int x, int y, int width, int height);
+
+		private:
+			void clamp();
+			int view_width;
+			int view_height;
+			int world_width;
+			int world_height;
+			double min_zoom;
+			double x;
+			double y;
+			double zoom;
+	};
+}
+
+#endif /* INCLUDE_CAMERA_H_ */
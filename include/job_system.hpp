@@ -0,0 +1,129 @@
+#ifndef INCLUDE_JOB_SYSTEM_H_
+#define INCLUDE_JOB_SYSTEM_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "arena.hpp"
+
+namespace villa
+{
+	/**
+	 * Job type enumeration.
+	 * Used to group the timing statistics of jobs.
+	 */
+	enum class jobtype
+	{
+		general,           //!< general
+		villager_decision, //!< villager_decision
+		resource_update,   //!< resource_update
+		map_generation     //!< map_generation
+	};
+
+	/**
+	 * Job Stats struct.
+	 * Timing statistics of the jobs of a single type.
+	 */
+	struct jobstats
+	{
+		unsigned long jobs; //!< Number of jobs run
+		double seconds;     //!< Total time spent running the jobs
+	};
+
+	class job_counter;
+
+	/**
+	 * Job struct.
+	 * A function to run, and the counter to decrement once it has run.
+	 * The job allocates from the arena that was current on the thread that added it, whichever thread runs it.
+	 */
+	struct job
+	{
+		jobtype type;
+		std::function<void()> function;
+		job_counter* counter;
+		arena* allocator;
+	};
+
+	/**
+	 * Job Counter class.
+	 * Counts the unfinished jobs of a group. Jobs can wait for the group to finish,
+	 * either by waiting on the counter or by being added with the counter as a dependency.
+	 */
+	class job_counter
+	{
+		friend class job_system;
+
+		public:
+			job_counter();
+			job_counter(const job_counter&) = delete;
+			job_counter& operator=(const job_counter&) = delete;
+			bool get_finished();
+
+		private:
+			std::atomic<unsigned int> remaining;
+			std::mutex lock;
+			std::vector<job> continuations;
+	};
+
+	/**
+	 * Job System class.
+	 * Runs jobs across a fixed set of worker threads. Each thread has its own queue, taking its newest job first
+	 * and stealing the oldest jobs of other threads when its own queue is empty. A thread waiting for a group of
+	 * jobs runs jobs until the group has finished, so a job system with a single thread runs everything inline.
+	 */
+	class job_system
+	{
+		public:
+			static const unsigned int jobtype_count = 4;
+			job_system(unsigned int threads);
+			~job_system();
+			job_system(const job_system&) = delete;
+			job_system& operator=(const job_system&) = delete;
+			unsigned int get_thread_count();
+			void run(jobtype type, std::function<void()> function, job_counter* counter, job_counter* dependency = nullptr);
+			void wait(job_counter* counter);
+			void parallel_for(jobtype type, std::size_t count, std::size_t grain, const std::function<void(std::size_t)>& function);
+			jobstats get_stats(jobtype type);
+			void reset_stats();
+			static std::string get_jobtype_name(jobtype type);
+
+		private:
+			/**
+			 * Worker Queue struct.
+			 * The jobs waiting to be run by a thread.
+			 */
+			struct worker_queue
+			{
+				std::mutex lock;
+				std::deque<job> jobs;
+			};
+
+			void work(unsigned int index);
+			void push(job value);
+			bool take(unsigned int index, job& value);
+			void execute(job& value);
+			void record(jobtype type, unsigned long jobs, std::chrono::steady_clock::duration duration);
+			unsigned int get_index();
+			std::vector<std::unique_ptr<worker_queue>> queues;
+			std::vector<std::thread> workers;
+			std::atomic<unsigned int> queued;
+			std::mutex sleep_lock;
+			std::condition_variable wake;
+			bool stopping;
+			std::atomic<unsigned long> stats_jobs[jobtype_count];
+			std::atomic<unsigned long long> stats_nanoseconds[jobtype_count];
+			static thread_local job_system* worker_owner;
+			static thread_local unsigned int worker_index;
+	};
+}
+
+#endif /* INCLUDE_JOB_SYSTEM_H_ */
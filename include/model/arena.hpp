@@ -0,0 +1,129 @@
+#ifndef INCLUDE_ARENA_H_
+#define INCLUDE_ARENA_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace villa
+{
+	/**
+	 * Arena Stats struct.
+	 * Allocation statistics of an arena.
+	 */
+	struct arenastats
+	{
+		std::size_t chunks;        //!< Number of chunks reserved
+		std::size_t reserved;      //!< Bytes reserved in chunks
+		std::size_t used;          //!< Bytes handed out from chunks (including freed blocks)
+		std::size_t allocations;   //!< Total number of allocations
+		std::size_t deallocations; //!< Total number of deallocations
+		std::size_t reused;        //!< Allocations served from the free lists
+		std::size_t live;          //!< Allocations not yet deallocated
+	};
+
+	/**
+	 * Arena class.
+	 * Allocates simulation objects from large chunks of memory which are released together
+	 * when the arena is destroyed. Freed blocks are kept in per-size free lists and reused,
+	 * so objects that are frequently created and destroyed (tasks, items) do not reach the heap.
+	 * Each block is prefixed by a header recording its owning arena and size class.
+	 * Each thread caches free blocks and unused space of one arena at a time, so most allocations and deallocations
+	 * do not take the arena's lock. Blocks move between a thread's cache and the arena in batches.
+	 * The current arena is also kept per thread.
+	 */
+	class arena
+	{
+		public:
+			arena(std::size_t chunk_size = 65536);
+			~arena();
+			arena(const arena&) = delete;
+			arena& operator=(const arena&) = delete;
+			arenastats get_stats();
+			static void* allocate(arena* owner, std::size_t size);
+			static void deallocate(void* value);
+			static arena* get_current();
+			static void set_current(arena* value);
+
+		private:
+			static const std::size_t alignment = 16;
+			static const std::size_t header_size = 16;
+			static const std::size_t class_count = 64;
+			static const std::size_t batch_size = 32;
+			static const std::size_t slab_size = 4096;
+
+			/**
+			 * Free Block struct.
+			 * Links a freed block to the next block of the same size class.
+			 */
+			struct free_block
+			{
+				free_block* next;
+			};
+
+			/**
+			 * Header struct.
+			 * Stored in front of each block (owner is nullptr for heap blocks).
+			 */
+			struct header
+			{
+				arena* owner;
+				std::uint32_t size_class;
+			};
+
+			/**
+			 * Thread Cache struct.
+			 * The free blocks and unused space of an arena kept by a single thread.
+			 * Its statistics are only changed by its thread, and are read by the arena while holding its lock.
+			 */
+			struct thread_cache
+			{
+				arena* owner;
+				free_block* free_lists[class_count];
+				std::size_t free_counts[class_count];
+				char* position;
+				char* limit;
+				std::atomic<std::size_t> used;
+				std::atomic<std::size_t> allocations;
+				std::atomic<std::size_t> deallocations;
+				std::atomic<std::size_t> reused;
+
+				thread_cache();
+				~thread_cache();
+			};
+
+			void* allocate_block(std::size_t size_class);
+			void release_block(void* block, std::size_t size_class);
+			void bind(thread_cache& value);
+			void unbind(thread_cache& value);
+			void refill(thread_cache& value, std::size_t size_class);
+			static void count(std::atomic<std::size_t>& value, std::size_t amount);
+			std::vector<char*> chunks;
+			std::size_t chunk_size;
+			char* position;
+			char* limit;
+			free_block* free_lists[class_count];
+			arenastats stats;
+			std::vector<thread_cache*> caches;
+			std::mutex lock;
+			static thread_local arena* current;
+			static thread_local thread_cache cache;
+	};
+
+	/**
+	 * Arena Allocated class.
+	 * Base class for objects that are allocated from the current arena when created with new.
+	 * Objects created while no arena is current are allocated from the heap.
+	 */
+	class arena_allocated
+	{
+		public:
+			static void* operator new(std::size_t size);
+			static void operator delete(void* value);
+	};
+}
+
+#endif /* INCLUDE_ARENA_H_ */
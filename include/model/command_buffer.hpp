@@ -0,0 +1,62 @@
+#ifndef INCLUDE_COMMAND_BUFFER_H_
+#define INCLUDE_COMMAND_BUFFER_H_
+
+#include <vector>
+#include "building.hpp"
+#include "resource.hpp"
+#include "villager.hpp"
+
+namespace villa
+{
+	class map;
+
+	/**
+	 * Command type enumeration.
+	 */
+	enum class commandtype
+	{
+		add_building,   //!< add_building
+		add_resource,   //!< add_resource
+		add_villager,   //!< add_villager
+		remove_building,//!< remove_building
+		remove_resource,//!< remove_resource
+		remove_villager //!< remove_villager
+	};
+
+	/**
+	 * Command Buffer class.
+	 * Records structural changes to the map while its entities are being iterated,
+	 * so that they can be applied together once iteration has finished.
+	 */
+	class command_buffer
+	{
+		/**
+		 * Command struct.
+		 * Entities to add are owned by the command buffer until applied.
+		 * Entities to remove are referenced by handle, so removing an entity twice is harmless.
+		 */
+		struct command
+		{
+			commandtype type;
+			entity* value;
+			handle target;
+		};
+
+		public:
+			~command_buffer();
+			void add_building(building* value);
+			void add_resource(resource* value);
+			void add_villager(villager* value);
+			void remove_building(building* value);
+			void remove_resource(resource* value);
+			void remove_villager(villager* value);
+			void apply(map* target);
+			void clear();
+			int size();
+
+		private:
+			std::vector<command> commands;
+	};
+}
+
+#endif /* INCLUDE_COMMAND_BUFFER_H_ */
@@ -2,15 +2,28 @@
 #define INCLUDE_ENTITY_H_
 
 #include <memory>
+#include "arena.hpp"
 #include "inventory.hpp"
+#include "slot_map.hpp"
 
 namespace villa
 {
+	/**
+	 * Entity type enumeration.
+	 */
+	enum class entitytype
+	{
+		null,    //!< null
+		villager,//!< villager
+		resource,//!< resource
+		building //!< building
+	};
+
 	/**
 	 * Entity class.
 	 * Represents all entities that physically appear in the simulation.
 	 */
-	class entity
+	class entity : public arena_allocated
 	{
 		public:
 			virtual bool is_at(double x, double y);
@@ -19,6 +32,8 @@ namespace villa
 			double get_y();
 			void set_y(double value);
 			inventory* get_inventory();
+			handle get_handle();
+			void set_handle(handle value);
 
 		protected:
 			entity();
@@ -27,6 +42,7 @@ namespace villa
 			double x;
 			double y;
 			std::unique_ptr<inventory> storage;
+			handle id;
 	};
 }
 
@@ -1,6 +1,7 @@
 #ifndef INCLUDE_INVENTORY_H_
 #define INCLUDE_INVENTORY_H_
 
+#include "arena.hpp"
 #include "item.hpp"
 #include "tool.hpp"
 #include <vector>
@@ -12,7 +13,7 @@ namespace villa
 	 * Inventory class.
 	 * Represents a collection of items stored by the parent entity.
 	 */
-	class inventory
+	class inventory : public arena_allocated
 	{
 		public:
 			int get_item_count();
@@ -23,6 +24,7 @@ namespace villa
 			void remove_item(item* value);
 			void remove_item(itemtype type);
 			item* get_item(itemtype type);
+			item* find_item(unsigned long id);
 			std::vector<item*> get_items();
 			tool* get_tool_highest_efficiency(itemtype type);
 
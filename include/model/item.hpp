@@ -1,6 +1,9 @@
 #ifndef INCLUDE_ITEM_H_
 #define INCLUDE_ITEM_H_
 
+#include <atomic>
+#include "arena.hpp"
+
 namespace villa
 {
 	/**
@@ -22,16 +25,20 @@ namespace villa
 	/**
 	 * Item class.
 	 * Represents items that are collected and stored in inventories.
+	 * Each item has a unique id, so that tasks can find it again without holding a pointer that may be reused.
 	 */
-	class item
+	class item : public arena_allocated
 	{
 		public:
 			item();
 			item(itemtype type);
+			unsigned long get_id();
 			itemtype get_type();
 			void set_type(itemtype value);
 
 		private:
+			static std::atomic<unsigned long> next_id;
+			unsigned long id;
 			itemtype type;
 	};
 }
@@ -1,16 +1,26 @@
 #ifndef INCLUDE_MAP_H_
 #define INCLUDE_MAP_H_
 
+#include <algorithm>
+#include <functional>
 #include <random>
 #include <time.h>
 #include "PerlinNoise.h"
+#include "arena.hpp"
 #include "building.hpp"
+#include "command_buffer.hpp"
 #include "resource.hpp"
+#include "slot_map.hpp"
 #include "tile.hpp"
 #include "villager.hpp"
 
 namespace villa
 {
+	/**
+	 * Runs a function once for each index from 0 to count - 1, in any order, and returns once all have run.
+	 */
+	typedef std::function<void(std::size_t count, const std::function<void(std::size_t)>& function)> loop_runner;
+
 	/**
 	 * Map class.
 	 * Represents the simulation area which contains all entities within it.
@@ -18,29 +28,124 @@ namespace villa
 	class map
 	{
 		public:
-			map(std::mt19937& rng);
+			map(std::mt19937& rng, const loop_runner& rows = loop_runner());
 			bool add_building(building* value);
 			void remove_building(building* value);
 			void add_resource(resource* value);
 			void remove_resource(resource* value);
 			bool add_villager(villager* value);
 			void remove_villager(villager* value);
-			std::vector<building*> get_buildings();
-			std::vector<resource*> get_resources();
-			std::vector<villager*> get_villagers();
+			slot_view<building> get_buildings();
+			slot_view<resource> get_resources();
+			slot_view<villager> get_villagers();
+			template<typename F> void for_each_building(F callback);
+			template<typename F> void for_each_resource(F callback);
+			template<typename F> void for_each_villager(F callback);
+			template<typename F> void for_each_resource_in(int first_x, int first_y, int last_x, int last_y, F callback);
+			building* get_building(handle value);
+			resource* get_resource(handle value);
+			villager* get_villager(handle value);
+			entity* get_entity(entitytype type, handle value);
 			int get_resource_count(resourcetype value);
 			tile* get_tile_at(int x, int y);
+			void set_tile_type(int x, int y, tiletype value);
+			std::vector<resource*> get_resources_at(int x, int y);
 			std::pair<int, int> get_tile_coords(tile* value);
 			std::vector<tile*> get_neighbour_tiles(int x, int y);
+			std::vector<std::pair<int, int>> get_neighbour_coords(int x, int y);
 			bool get_available_space(int x, int y, buildingtype value);
+			command_buffer* get_commands();
+			void apply_commands();
+			void mark_resource_changed(resource* value);
+			std::vector<handle> take_changed_resources();
+			void mark_terrain_changed();
+			unsigned long get_terrain_version();
+			arenastats get_allocation_stats();
+			void use_allocator();
 
 		private:
-			std::vector<std::unique_ptr<building>> buildings;
-			std::vector<std::unique_ptr<resource>> resources;
+			void update_tile_variant(int x, int y);
+			// Declared first so that it is destroyed after all entities allocated from it
+			arena allocator;
+			slot_map<building> buildings;
+			slot_map<resource> resources;
 			std::unique_ptr<tile> tiles[50][50];
-			std::vector<std::unique_ptr<villager>> villagers;
+			// Handles of the resources on each tile
+			std::vector<handle> tile_resources[50][50];
+			slot_map<villager> villagers;
+			command_buffer commands;
+			std::vector<handle> changed_resources;
+			unsigned long terrain_version;
 			std::mt19937& rng;
 	};
+
+	/**
+	 * Calls the function with each building, without copying the building storage.
+	 * The function must not add or remove entities directly (use the command buffer instead).
+	 * @param callback - The function to call, taking a building pointer.
+	 */
+	template<typename F> void map::for_each_building(F callback)
+	{
+		for(slot_map<building>::const_iterator iterator = this->buildings.begin(); iterator != this->buildings.end(); ++iterator)
+		{
+			callback(iterator->get());
+		}
+	}
+
+	/**
+	 * Calls the function with each resource, without copying the resource storage.
+	 * The function must not add or remove entities directly (use the command buffer instead).
+	 * @param callback - The function to call, taking a resource pointer.
+	 */
+	template<typename F> void map::for_each_resource(F callback)
+	{
+		for(slot_map<resource>::const_iterator iterator = this->resources.begin(); iterator != this->resources.end(); ++iterator)
+		{
+			callback(iterator->get());
+		}
+	}
+
+	/**
+	 * Calls the function with each villager, without copying the villager storage.
+	 * The function must not add or remove entities directly (use the command buffer instead).
+	 * @param callback - The function to call, taking a villager pointer.
+	 */
+	template<typename F> void map::for_each_villager(F callback)
+	{
+		for(slot_map<villager>::const_iterator iterator = this->villagers.begin(); iterator != this->villagers.end(); ++iterator)
+		{
+			callback(iterator->get());
+		}
+	}
+
+	/**
+	 * Calls the function with each resource on the tiles within the rectangle, using the resources on each tile.
+	 * Tiles are visited row by row, so resources further down the map are visited later.
+	 * The function must not add or remove entities directly (use the command buffer instead).
+	 * @param first_x - The x-coord of the left column of tiles.
+	 * @param first_y - The y-coord of the top row of tiles.
+	 * @param last_x - The x-coord of the right column of tiles (inclusive).
+	 * @param last_y - The y-coord of the bottom row of tiles (inclusive).
+	 * @param callback - The function to call, taking a resource pointer.
+	 */
+	template<typename F> void map::for_each_resource_in(int first_x, int first_y, int last_x, int last_y, F callback)
+	{
+		for(int j = std::max(first_y, 0); j <= std::min(last_y, 49); ++j)
+		{
+			for(int i = std::max(first_x, 0); i <= std::min(last_x, 49); ++i)
+			{
+				for(std::vector<handle>::const_iterator iterator = this->tile_resources[i][j].begin(); iterator != this->tile_resources[i][j].end(); ++iterator)
+				{
+					resource* value = this->resources.get(*iterator);
+
+					if(value != nullptr)
+					{
+						callback(value);
+					}
+				}
+			}
+		}
+	}
 }
 
 #endif /* INCLUDE_MAP_H_ */
@@ -0,0 +1,51 @@
+#ifndef INCLUDE_NEEDS_BATCH_H_
+#define INCLUDE_NEEDS_BATCH_H_
+
+#include <string>
+#include <vector>
+#include "villager.hpp"
+
+namespace villa
+{
+	/**
+	 * Needs kernel enumeration.
+	 */
+	enum class needskernel
+	{
+		scalar,//!< scalar
+		sse2,  //!< sse2
+		avx2   //!< avx2
+	};
+
+	/**
+	 * Needs Batch class.
+	 * Applies the periodic health and needs rules to a batch of villagers.
+	 * Villager stats are gathered into separate arrays so that each rule can be vectorised.
+	 */
+	class needs_batch
+	{
+		public:
+			needs_batch();
+			void clear();
+			void add_villager(villager* value);
+			void update(bool update_health, bool update_health_regen, bool update_needs);
+			void store();
+			int size();
+			needskernel get_kernel();
+			void set_kernel(needskernel value);
+			static bool get_kernel_supported(needskernel value);
+			static needskernel get_kernel_best();
+			static std::string get_kernel_name(needskernel value);
+			static void update(int* health, int* hunger, int* thirst, int* fatigue, int count, bool update_health, bool update_health_regen, bool update_needs, needskernel kernel);
+
+		private:
+			needskernel kernel;
+			std::vector<villager*> villagers;
+			std::vector<int> health;
+			std::vector<int> hunger;
+			std::vector<int> thirst;
+			std::vector<int> fatigue;
+	};
+}
+
+#endif /* INCLUDE_NEEDS_BATCH_H_ */
@@ -0,0 +1,48 @@
+#ifndef INCLUDE_RANDOM_STREAM_H_
+#define INCLUDE_RANDOM_STREAM_H_
+
+#include <cstdint>
+#include "slot_map.hpp"
+
+namespace villa
+{
+	/**
+	 * Random purpose enumeration.
+	 * Each kind of random decision draws from its own stream.
+	 */
+	enum class randompurpose
+	{
+		idle,             //!< idle
+		build,            //!< build
+		rest,             //!< rest
+		needs,            //!< needs
+		resource_regrowth //!< resource_regrowth
+	};
+
+	/**
+	 * Random Stream class.
+	 * A counter-based random number generator (Philox4x32-10) keyed by the simulation seed, tick,
+	 * entity and purpose. The numbers an entity draws do not depend on how many numbers other entities
+	 * have drawn, so entities can be processed in any order (or concurrently) with the same results.
+	 * Satisfies the requirements of a uniform random bit generator, so it can be used with std distributions.
+	 */
+	class random_stream
+	{
+		public:
+			typedef std::uint32_t result_type;
+
+			random_stream(std::uint32_t seed, std::uint32_t tick, handle entity, randompurpose purpose);
+			result_type operator()();
+			static constexpr result_type min() { return 0; }
+			static constexpr result_type max() { return 0xFFFFFFFF; }
+			static void philox(const std::uint32_t counter[4], const std::uint32_t key[2], std::uint32_t result[4]);
+
+		private:
+			std::uint32_t key[2];
+			std::uint32_t counter[4];
+			std::uint32_t block[4];
+			int position;
+	};
+}
+
+#endif /* INCLUDE_RANDOM_STREAM_H_ */
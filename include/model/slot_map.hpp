@@ -0,0 +1,341 @@
+#ifndef INCLUDE_SLOT_MAP_H_
+#define INCLUDE_SLOT_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace villa
+{
+	/**
+	 * Handle struct.
+	 * Refers to a value stored in a slot map.
+	 * The generation changes each time a slot is reused, so handles to removed values can be detected.
+	 * Generation 0 is never used, so a default handle never refers to a value.
+	 */
+	struct handle
+	{
+		std::uint32_t index;
+		std::uint32_t generation;
+	};
+
+	inline bool operator==(handle a, handle b)
+	{
+		return a.index == b.index && a.generation == b.generation;
+	}
+
+	inline bool operator!=(handle a, handle b)
+	{
+		return !(a == b);
+	}
+
+	/**
+	 * Slot View class.
+	 * A lightweight, non-owning view of the values in a slot map.
+	 * Iterating the view yields raw pointers to the values without copying them.
+	 * The view is invalidated when values are inserted or removed.
+	 */
+	template<typename T> class slot_view
+	{
+		typedef typename std::vector<std::unique_ptr<T>>::const_iterator position_type;
+
+		public:
+			/**
+			 * Iterator class.
+			 * Dereferences to a raw pointer to the value.
+			 */
+			class iterator
+			{
+				public:
+					typedef std::forward_iterator_tag iterator_category;
+					typedef T* value_type;
+					typedef std::ptrdiff_t difference_type;
+					typedef T* const* pointer;
+					typedef T* reference;
+
+					iterator(position_type position) : position(position) { }
+					T* operator*() const { return this->position->get(); }
+					iterator& operator++() { ++this->position; return *this; }
+					iterator operator++(int) { iterator target = *this; ++this->position; return target; }
+					bool operator==(const iterator& other) const { return this->position == other.position; }
+					bool operator!=(const iterator& other) const { return this->position != other.position; }
+
+				private:
+					position_type position;
+			};
+
+			slot_view(position_type first, position_type last);
+			iterator begin();
+			iterator end();
+			std::size_t size();
+			bool empty();
+			T* operator[](std::size_t index);
+
+		private:
+			position_type first;
+			position_type last;
+	};
+
+	/**
+	 * Constructor for the Slot View class.
+	 * @param first - The position of the first value.
+	 * @param last - The position past the last value.
+	 */
+	template<typename T> slot_view<T>::slot_view(position_type first, position_type last) : first(first), last(last) { }
+
+	/**
+	 * Gets an iterator to the first value.
+	 * @return The iterator.
+	 */
+	template<typename T> typename slot_view<T>::iterator slot_view<T>::begin()
+	{
+		return iterator(this->first);
+	}
+
+	/**
+	 * Gets an iterator past the last value.
+	 * @return The iterator.
+	 */
+	template<typename T> typename slot_view<T>::iterator slot_view<T>::end()
+	{
+		return iterator(this->last);
+	}
+
+	/**
+	 * Gets the number of values in the view.
+	 * @return The number of values.
+	 */
+	template<typename T> std::size_t slot_view<T>::size()
+	{
+		return this->last - this->first;
+	}
+
+	/**
+	 * Gets whether the view contains no values.
+	 * @return Boolean representing whether the view is empty.
+	 */
+	template<typename T> bool slot_view<T>::empty()
+	{
+		return this->first == this->last;
+	}
+
+	/**
+	 * Gets the value at the position in the view.
+	 * @param index - The position of the value (must be less than the size).
+	 * @return The value.
+	 */
+	template<typename T> T* slot_view<T>::operator[](std::size_t index)
+	{
+		return (this->first + index)->get();
+	}
+
+	/**
+	 * Slot Map class.
+	 * Owns a collection of values with O(1) insertion, removal and handle lookup.
+	 * Values are kept densely packed for iteration. Removal moves the last value into the gap,
+	 * so iteration order is not preserved across removals.
+	 */
+	template<typename T> class slot_map
+	{
+		/**
+		 * Slot struct.
+		 * Points to the position of a value in the dense storage, or to the next free slot.
+		 */
+		struct slot
+		{
+			std::uint32_t index;
+			std::uint32_t generation;
+		};
+
+		public:
+			typedef typename std::vector<std::unique_ptr<T>>::const_iterator const_iterator;
+
+			slot_map();
+			handle insert(T* value);
+			std::unique_ptr<T> take(handle value);
+			bool erase(handle value);
+			T* get(handle value);
+			T* at(std::size_t index);
+			std::size_t size();
+			bool empty();
+			void clear();
+			const_iterator begin();
+			const_iterator end();
+			slot_view<T> get_view();
+
+		private:
+			static const std::uint32_t npos = 0xFFFFFFFF;
+			std::vector<slot> slots;
+			std::vector<std::unique_ptr<T>> values;
+			std::vector<std::uint32_t> value_slots;
+			std::uint32_t free_head;
+	};
+
+	/**
+	 * Constructor for the Slot Map class.
+	 */
+	template<typename T> slot_map<T>::slot_map() : free_head(npos) { }
+
+	/**
+	 * Inserts the value into the slot map, taking ownership of it.
+	 * @param value - The value to insert.
+	 * @return The handle of the value (default handle if the value is a null pointer).
+	 */
+	template<typename T> handle slot_map<T>::insert(T* value)
+	{
+		handle target = {0, 0};
+
+		if(value != nullptr)
+		{
+			// Reuse a free slot if one exists, otherwise create a new slot
+			if(this->free_head != npos)
+			{
+				target.index = this->free_head;
+				this->free_head = this->slots[target.index].index;
+			}
+			else
+			{
+				target.index = this->slots.size();
+				this->slots.push_back(slot{npos, 1});
+			}
+
+			target.generation = this->slots[target.index].generation;
+			this->slots[target.index].index = this->values.size();
+			this->values.push_back(std::unique_ptr<T>(value));
+			this->value_slots.push_back(target.index);
+		}
+
+		return target;
+	}
+
+	/**
+	 * Removes the value from the slot map, returning ownership of it.
+	 * @param value - The handle of the value.
+	 * @return The value (nullptr if the handle does not refer to a value).
+	 */
+	template<typename T> std::unique_ptr<T> slot_map<T>::take(handle value)
+	{
+		std::unique_ptr<T> target;
+
+		if(get(value) != nullptr)
+		{
+			std::uint32_t index = this->slots[value.index].index;
+			target = std::move(this->values[index]);
+
+			// Move the last value into the gap to keep the values densely packed
+			if(index != this->values.size() - 1)
+			{
+				this->values[index] = std::move(this->values.back());
+				this->value_slots[index] = this->value_slots.back();
+				this->slots[this->value_slots[index]].index = index;
+			}
+
+			this->values.pop_back();
+			this->value_slots.pop_back();
+
+			// Invalidate existing handles to the slot and add it to the free list
+			// Generation 0 is skipped when the generation wraps around
+			this->slots[value.index].generation = this->slots[value.index].generation + 1 != 0 ? this->slots[value.index].generation + 1 : 1;
+			this->slots[value.index].index = this->free_head;
+			this->free_head = value.index;
+		}
+
+		return target;
+	}
+
+	/**
+	 * Removes and destroys the value.
+	 * @param value - The handle of the value.
+	 * @return Boolean representing whether the handle referred to a value.
+	 */
+	template<typename T> bool slot_map<T>::erase(handle value)
+	{
+		return take(value) != nullptr;
+	}
+
+	/**
+	 * Gets the value with the associated handle.
+	 * @param value - The handle of the value.
+	 * @return The value (nullptr if the value has been removed).
+	 */
+	template<typename T> T* slot_map<T>::get(handle value)
+	{
+		if(value.index < this->slots.size() && this->slots[value.index].generation == value.generation && this->slots[value.index].index != npos)
+		{
+			return this->values[this->slots[value.index].index].get();
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * Gets the value at the position in the dense storage.
+	 * @param index - The position of the value.
+	 * @return The value (nullptr if out of range).
+	 */
+	template<typename T> T* slot_map<T>::at(std::size_t index)
+	{
+		return index < this->values.size() ? this->values[index].get() : nullptr;
+	}
+
+	/**
+	 * Gets the number of values in the slot map.
+	 * @return The number of values.
+	 */
+	template<typename T> std::size_t slot_map<T>::size()
+	{
+		return this->values.size();
+	}
+
+	/**
+	 * Gets whether the slot map contains no values.
+	 * @return Boolean representing whether the slot map is empty.
+	 */
+	template<typename T> bool slot_map<T>::empty()
+	{
+		return this->values.empty();
+	}
+
+	/**
+	 * Removes and destroys all values, invalidating all existing handles.
+	 */
+	template<typename T> void slot_map<T>::clear()
+	{
+		while(!this->values.empty())
+		{
+			std::uint32_t index = this->value_slots.back();
+			erase(handle{index, this->slots[index].generation});
+		}
+	}
+
+	/**
+	 * Gets an iterator to the first value in the dense storage.
+	 * @return The iterator.
+	 */
+	template<typename T> typename slot_map<T>::const_iterator slot_map<T>::begin()
+	{
+		return this->values.begin();
+	}
+
+	/**
+	 * Gets an iterator past the last value in the dense storage.
+	 * @return The iterator.
+	 */
+	template<typename T> typename slot_map<T>::const_iterator slot_map<T>::end()
+	{
+		return this->values.end();
+	}
+
+	/**
+	 * Gets a view of the values in the dense storage.
+	 * @return The view.
+	 */
+	template<typename T> slot_view<T> slot_map<T>::get_view()
+	{
+		return slot_view<T>(this->values.begin(), this->values.end());
+	}
+}
+
+#endif /* INCLUDE_SLOT_MAP_H_ */
@@ -2,30 +2,36 @@
 #define INCLUDE_MODEL_TASK_HPP_
 
 #include <unordered_map>
+#include "arena.hpp"
 #include "building.hpp"
 #include "entity.hpp"
 #include "item.hpp"
+#include "resource.hpp"
 #include "tile.hpp"
 
 namespace villa
 {
 	/**
 	 * Task data union.
+	 * Entities on the map are referenced by handle and items by id, so tasks can detect when their target has been removed.
+	 * The target building of a build task is not on the map yet, so it is owned by the task until placed.
 	 */
 	struct taskdata
 	{
 		taskdata(std::pair<int, int> target_coords);
-		taskdata(std::pair<int, int> target_coords, entity* target_entity);
+		taskdata(std::pair<int, int> target_coords, resource* target_resource);
 		taskdata(std::pair<int, int> target_coords, building* target_building);
-		taskdata(std::pair<int, int> target_coords, std::pair<entity*, item*> target_item);
+		taskdata(std::pair<int, int> target_coords, std::pair<building*, item*> target_item);
+		taskdata(std::pair<int, int> target_coords, std::pair<resource*, item*> target_item);
 		taskdata(std::pair<int, int> target_coords, int time);
 
 		std::pair<int, int> target_coords;
+		entitytype target_type;
 		union
 		{
-			entity* target_entity;
+			handle target_entity;
 			building* target_building;
-			std::pair<entity*, item*> target_item;
+			std::pair<handle, unsigned long> target_item;
 			int time;
 		};
 	};
@@ -48,7 +54,7 @@ namespace villa
 	 * Task class.
 	 * Represents a task that can be carried out by villagers.
 	 */
-	class task
+	class task : public arena_allocated
 	{
 		public:
 			task(tasktype type, taskdata data);
@@ -1,6 +1,8 @@
 #ifndef INCLUDE_TILE_H_
 #define INCLUDE_TILE_H_
 
+#include "arena.hpp"
+
 namespace villa
 {
 	/**
@@ -14,23 +16,48 @@ namespace villa
 		sand  //!< sand
 	};
 
+	/**
+	 * Tile variant enumeration.
+	 * The edge or corner of its tile type that a tile is on, selecting the texture it is displayed with.
+	 */
+	enum class tilevariant
+	{
+		centre,           //!< centre (no edge)
+		north,            //!< north edge
+		north_east,       //!< north and east edges
+		east,             //!< east edge
+		south_east,       //!< south and east edges
+		south,            //!< south edge
+		south_west,       //!< south and west edges
+		west,             //!< west edge
+		north_west,       //!< north and west edges
+		corner_north_east,//!< inner corner (different tile to the south-west)
+		corner_north_west,//!< inner corner (different tile to the north-east)
+		corner_south_east,//!< inner corner (different tile to the north-west)
+		corner_south_west //!< inner corner (different tile to the south-east)
+	};
+
 	/**
 	 * Tile class.
 	 * Represents each square of the grid-based map.
 	 */
-	class tile
+	class tile : public arena_allocated
 	{
 		public:
+			static const int variant_count = 13;
 			tile();
 			tile(tiletype type, bool pathable);
 			tiletype get_type();
 			void set_type(tiletype type);
 			bool get_pathable();
 			void set_pathable(bool value);
+			tilevariant get_variant();
+			void set_variant(tilevariant value);
 
 		private:
 			tiletype type;
 			bool pathable;
+			tilevariant variant;
 	};
 }
 
@@ -19,7 +19,7 @@ namespace villa
 			villager(double x, double y);
 			void move(double x, double y, double value);
 			void rest(double value);
-			void harvest();
+			void harvest(resource* target);
 			void add_task(task* value);
 			void remove_task();
 			task* get_task();
@@ -34,6 +34,9 @@ namespace villa
 			void set_thirst(int value);
 			int get_fatigue();
 			void set_fatigue(int value);
+			double get_previous_x();
+			double get_previous_y();
+			void store_position();
 
 		private:
 			int speed;
@@ -41,6 +44,9 @@ namespace villa
 			int hunger;
 			int thirst;
 			int fatigue;
+			// The position at the start of the current tick, so that movement can be displayed between ticks
+			double previous_x;
+			double previous_y;
 			std::stack<std::unique_ptr<task>> tasks;
 	};
 }
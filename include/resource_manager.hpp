@@ -1,15 +1,86 @@
 #ifndef INCLUDE_RESOURCE_MANAGER_H_
 #define INCLUDE_RESOURCE_MANAGER_H_
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <list>
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+#include "atlas_packer.hpp"
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 
 namespace villa
 {
+	/**
+	 * Texture handle type.
+	 * Refers to a loaded texture without looking up its name (0 refers to no texture).
+	 */
+	typedef unsigned int texture_handle;
+
+	/**
+	 * Font handle type.
+	 * Refers to a loaded font at a single size without looking up its name (0 refers to no font).
+	 */
+	typedef unsigned int font_handle;
+
+	/**
+	 * Atlas Region struct.
+	 * The part of an atlas texture that holds a single image.
+	 */
+	struct atlas_region
+	{
+		SDL_Texture* texture; //!< The atlas texture
+		SDL_Rect rect;        //!< The position and size of the image within the atlas
+	};
+
+	/**
+	 * Sprite Part struct.
+	 * A texture drawn as part of a composite texture.
+	 */
+	struct sprite_part
+	{
+		texture_handle texture; //!< The texture of the part
+		int x;                  //!< The x-coord of the part within the composite texture
+		int y;                  //!< The y-coord of the part within the composite texture
+	};
+
+	/**
+	 * Text Texture struct.
+	 * A string rendered in white, kept so that it can be drawn again with a single blit.
+	 */
+	struct text_texture
+	{
+		std::string text;     //!< The rendered string
+		font_handle font;     //!< The font the string was rendered with
+		SDL_Texture* texture; //!< The texture (nullptr if it could not be created)
+		int width;            //!< The width of the texture
+		int height;           //!< The height of the texture
+	};
+
+	/**
+	 * Glyph Atlas struct.
+	 * The printable ASCII characters of a font at a single size, rendered in white into one texture.
+	 */
+	struct glyph_atlas
+	{
+		static const int FIRST_GLYPH = 32;
+		static const int GLYPH_COUNT = 95;
+		TTF_Font* font;                        //!< The font
+		SDL_Texture* texture;                  //!< The atlas texture
+		SDL_Surface* surface;                  //!< The atlas surface, kept to render whole strings from
+		SDL_Rect glyphs[GLYPH_COUNT];          //!< The position of each glyph within the atlas (the width is its advance)
+		int kerning[GLYPH_COUNT][GLYPH_COUNT]; //!< The adjustment to the advance between each pair of glyphs
+		std::unordered_map<std::string, std::list<text_texture>::iterator> texts; //!< The cached strings rendered with the font
+	};
+
 	/**
 	 * Resource Manager class.
 	 * Handles all resource files used by the application.
@@ -19,19 +90,43 @@ namespace villa
 		public:
 			resource_manager(SDL_Renderer& renderer);
 			void unload_resources();
-			void load_texture(std::string name, std::string path);
-			void load_font(std::string name, std::string path, int size);
-			void render_texture(int x, int y, std::string name);
-			void render_text(int x, int y, std::string text, std::string font, int size, SDL_Color color);
-			SDL_Texture* get_texture(std::string name);
-			SDL_Texture* get_texture_text(std::string text, std::string font, int size, SDL_Color color);
-			TTF_Font* get_font(std::string name, int size);
+			texture_handle load_texture(std::string name, std::string path);
+			texture_handle compose_texture(std::string name, const std::vector<sprite_part>& parts);
+			void build_atlas();
+			font_handle load_font(std::string name, std::string path, int size);
+			void set_view(double x, double y, double zoom);
+			void reset_view();
+			SDL_Rect get_view_rect(int x, int y, int width, int height);
+			void render_texture(int x, int y, texture_handle value);
+			void render_text(int x, int y, const std::string& text, font_handle font, SDL_Color color);
+			texture_handle get_texture_handle(std::string name);
+			atlas_region* get_texture(texture_handle value);
+			font_handle get_font_handle(std::string name, int size);
+			glyph_atlas* get_font(font_handle value);
 
 		private:
+			static const int ATLAS_SIZE = 2048;
+			static const unsigned int TEXT_CACHE_SIZE = 256;
+			SDL_Surface* create_atlas_surface(int width, int height);
+			SDL_Surface* get_image(texture_handle value);
+			std::vector<std::pair<int, int>> layout_text(const std::string& text, glyph_atlas* atlas);
+			text_texture* get_text_texture(const std::string& text, font_handle font);
+			void create_text_texture(text_texture& value);
 			SDL_Renderer& renderer;
-			std::unordered_map<std::string, SDL_Texture*> textures;
-			std::unordered_map<std::string, SDL_Texture*> textures_text;
-			std::unordered_map<std::string, TTF_Font*> fonts;
+			// The world position at the top left of the screen, and the scale of textures drawn with render_texture
+			double view_x;
+			double view_y;
+			double view_zoom;
+			std::vector<std::pair<texture_handle, SDL_Surface*>> images;
+			std::vector<SDL_Texture*> atlases;
+			// The atlas region of each texture, indexed by handle
+			std::vector<atlas_region> textures;
+			std::unordered_map<std::string, texture_handle> texture_names;
+			// The glyph atlas of each font, indexed by handle
+			std::vector<std::unique_ptr<glyph_atlas>> fonts;
+			std::map<std::pair<std::string, int>, font_handle> font_names;
+			// The cached strings of all fonts, from the most to the least recently rendered
+			std::list<text_texture> text_cache;
 	};
 }
 
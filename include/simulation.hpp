@@ -0,0 +1,90 @@
+#ifndef INCLUDE_SIMULATION_H_
+#define INCLUDE_SIMULATION_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <random>
+#include "ai_manager.hpp"
+#include "job_system.hpp"
+#include "map.hpp"
+#include "needs_batch.hpp"
+#include "simulation_snapshot.hpp"
+
+namespace villa
+{
+	/**
+	 * Simulation timer struct.
+	 * Times are in simulated milliseconds.
+	 */
+	struct simulation_timer_struct
+	{
+		unsigned int time;
+		unsigned int villager_health;
+		unsigned int villager_health_regen;
+		unsigned int villager_needs;
+	};
+
+	/**
+	 * Regrowth event struct.
+	 * A resource waiting until the time when it becomes harvestable again.
+	 */
+	struct regrowth_event
+	{
+		unsigned int time;
+		handle target;
+	};
+
+	inline bool operator>(const regrowth_event& a, const regrowth_event& b)
+	{
+		return a.time > b.time || (a.time == b.time && a.target.index > b.target.index);
+	}
+
+	/**
+	 * Simulation class.
+	 * Owns the map and villager AI of a single simulation and advances them in fixed ticks.
+	 * Each tick always covers the same amount of simulated time, so results do not depend on speed.
+	 * All randomness (terrain and decisions) is derived from the seed, so a seed always produces the same run.
+	 * Terrain is generated from a sequential generator, while decisions made during ticks draw from
+	 * per-entity random streams so that their results do not depend on the order entities are processed.
+	 * The number of threads does not change the result.
+	 * Does not depend on SDL, so it can be driven without a window.
+	 */
+	class simulation
+	{
+		public:
+			static const int UPDATE_TIME = 1000 / 60;
+			simulation(unsigned int seed, unsigned int threads = 1);
+			void tick();
+			bool get_finished();
+			unsigned int get_time();
+			unsigned long get_ticks();
+			unsigned int get_seed();
+			std::uint64_t get_state_hash();
+			void take_snapshot(simulation_snapshot& value);
+			map* get_map();
+			ai_manager* get_ai();
+			job_system* get_jobs();
+			needs_batch* get_needs();
+
+		private:
+			static const std::size_t RESOURCE_GRAIN = 64;
+			static const std::size_t MAP_GENERATION_GRAIN = 4;
+			void update();
+			void update_resource(resource* value);
+			static void hash_bytes(std::uint64_t& hash, const void* value, std::size_t size);
+			unsigned int seed;
+			std::mt19937 rng;
+			job_system jobs;
+			std::unique_ptr<map> simulation_map;
+			std::unique_ptr<ai_manager> simulation_ai;
+			needs_batch needs;
+			std::priority_queue<regrowth_event, std::vector<regrowth_event>, std::greater<regrowth_event>> regrowth;
+			simulation_timer_struct timers;
+			unsigned long ticks;
+	};
+}
+
+#endif /* INCLUDE_SIMULATION_H_ */
@@ -0,0 +1,60 @@
+#ifndef INCLUDE_SIMULATION_RUNNER_H_
+#define INCLUDE_SIMULATION_RUNNER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "simulation.hpp"
+#include "simulation_snapshot.hpp"
+#include "triple_buffer.hpp"
+
+namespace villa
+{
+	/**
+	 * Simulation Runner class.
+	 * Runs a simulation on its own thread at the requested speed, so that ticks and frames do not delay each other.
+	 * A snapshot is published after each batch of ticks for the displaying thread to take when it is ready,
+	 * and changes requested by the displaying thread are queued as commands that run between ticks.
+	 * Other than through commands, the simulation must only be used while the runner is stopped.
+	 */
+	class simulation_runner
+	{
+		public:
+			simulation_runner(unsigned int seed, unsigned int threads = 1);
+			~simulation_runner();
+			simulation_runner(const simulation_runner&) = delete;
+			simulation_runner& operator=(const simulation_runner&) = delete;
+			void start();
+			void stop();
+			void set_timescale(double value);
+			void set_fast_forward(bool value);
+			void run(std::function<void(simulation*)> command);
+			bool update_snapshot();
+			simulation_snapshot* get_snapshot();
+			simulation* get_simulation();
+
+		private:
+			static const int MAX_TICKS_BEHIND = 32;
+			static const int FAST_FORWARD_BUDGET = 16;
+			void work();
+			void run_commands();
+			void publish();
+			std::unique_ptr<simulation> simulation_state;
+			triple_buffer<simulation_snapshot> snapshots;
+			// The simulated time not yet covered by a tick, only used by the simulation thread
+			double accumulator;
+			std::thread worker;
+			std::mutex command_lock;
+			std::vector<std::function<void(simulation*)>> commands;
+			std::atomic<double> timescale;
+			std::atomic<bool> fast_forward;
+			std::atomic<bool> stopping;
+	};
+}
+
+#endif /* INCLUDE_SIMULATION_RUNNER_H_ */
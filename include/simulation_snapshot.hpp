@@ -0,0 +1,97 @@
+#ifndef INCLUDE_SIMULATION_SNAPSHOT_H_
+#define INCLUDE_SIMULATION_SNAPSHOT_H_
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include "building.hpp"
+#include "resource.hpp"
+#include "tile.hpp"
+
+namespace villa
+{
+	/**
+	 * Villager snapshot struct.
+	 * What is needed to display a villager.
+	 */
+	struct villager_snapshot
+	{
+		double x;            //!< The x-coord of the villager
+		double y;            //!< The y-coord of the villager
+		double previous_x;   //!< The x-coord of the villager before the last tick
+		double previous_y;   //!< The y-coord of the villager before the last tick
+		std::size_t variant; //!< Selects the texture of the villager
+
+		bool is_at(double x, double y) const;
+		double get_x(double alpha) const;
+		double get_y(double alpha) const;
+	};
+
+	/**
+	 * Resource snapshot struct.
+	 * What is needed to display a resource.
+	 */
+	struct resource_snapshot
+	{
+		double x;            //!< The x-coord of the resource
+		double y;            //!< The y-coord of the resource
+		resourcetype type;   //!< The type of the resource
+		bool harvestable;    //!< Whether the resource is harvestable
+		std::size_t variant; //!< Selects the texture of the resource
+
+		bool is_at(double x, double y) const;
+	};
+
+	/**
+	 * Building snapshot struct.
+	 * What is needed to display a building.
+	 */
+	struct building_snapshot
+	{
+		double x;            //!< The x-coord of the building
+		double y;            //!< The y-coord of the building
+		buildingtype type;   //!< The type of the building
+		int width;           //!< The width of the building in tiles
+		int height;          //!< The height of the building in tiles
+		std::size_t variant; //!< Selects the texture of the building
+
+		bool is_at(double x, double y) const;
+	};
+
+	/**
+	 * Tile snapshot struct.
+	 * What is needed to display a tile.
+	 */
+	struct tile_snapshot
+	{
+		tiletype type;       //!< The type of the tile
+		tilevariant variant; //!< The edge or corner the tile is on
+	};
+
+	/**
+	 * Simulation snapshot struct.
+	 * A copy of the simulation state that is displayed, taken after a tick so that it can be displayed
+	 * on another thread while the simulation continues. Its storage is reused by the next snapshot.
+	 */
+	struct simulation_snapshot
+	{
+		unsigned long ticks;                             //!< The number of ticks that have been run
+		unsigned int time;                               //!< The simulated time in milliseconds
+		double accumulator;                              //!< The simulated time in milliseconds not yet covered by a tick when published
+		double timescale;                                //!< The simulated milliseconds run per wall-clock millisecond when published
+		std::chrono::steady_clock::time_point published; //!< The time the snapshot was published
+		bool finished;                                   //!< Whether the simulation has ended
+		int resource_counts[6];                          //!< The number of harvestable resources of each type
+		unsigned long terrain_version;                   //!< The terrain version of the map when the tiles were copied
+		tile_snapshot tiles[50][50];                     //!< The tiles, only copied when the terrain version changes
+		std::vector<villager_snapshot> villagers;        //!< The villagers
+		std::vector<resource_snapshot> resources;        //!< The resources, ordered by the row of tiles they are on
+		std::size_t resource_rows[51];                   //!< The first resource on each row of tiles (and the end of the last row)
+		std::vector<building_snapshot> buildings;        //!< The buildings
+
+		simulation_snapshot();
+		double get_alpha(std::chrono::steady_clock::time_point now) const;
+	};
+}
+
+#endif /* INCLUDE_SIMULATION_SNAPSHOT_H_ */
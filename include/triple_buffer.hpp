@@ -0,0 +1,88 @@
+#ifndef INCLUDE_TRIPLE_BUFFER_H_
+#define INCLUDE_TRIPLE_BUFFER_H_
+
+#include <atomic>
+
+namespace villa
+{
+	/**
+	 * Triple Buffer class.
+	 * Passes the latest value from a single writer thread to a single reader thread without locking or copying.
+	 * The writer fills the back slot and publishes it, while the reader keeps using the front slot until it takes
+	 * the newest published slot. Neither thread waits for the other, and values published before the reader
+	 * catches up are skipped.
+	 */
+	template<typename T> class triple_buffer
+	{
+		public:
+			triple_buffer();
+			triple_buffer(const triple_buffer&) = delete;
+			triple_buffer& operator=(const triple_buffer&) = delete;
+			T& get_back();
+			void publish();
+			bool update();
+			T& get_front();
+
+		private:
+			// Set on the middle slot when it holds a value the reader has not taken yet
+			static const unsigned int FRESH = 4;
+			T slots[3];
+			std::atomic<unsigned int> middle;
+			unsigned int back;
+			unsigned int front;
+	};
+
+	/**
+	 * Constructor for the Triple Buffer class.
+	 */
+	template<typename T> triple_buffer<T>::triple_buffer() : middle(1), back(0), front(2) { }
+
+	/**
+	 * Gets the slot that the writer fills before publishing it.
+	 * Must only be called by the writer.
+	 * @return The back slot.
+	 */
+	template<typename T> T& triple_buffer<T>::get_back()
+	{
+		return slots[back];
+	}
+
+	/**
+	 * Publishes the back slot to the reader, and takes the previous middle slot as the new back slot.
+	 * The new back slot holds an older value, so the writer must fill it again.
+	 * Must only be called by the writer.
+	 */
+	template<typename T> void triple_buffer<T>::publish()
+	{
+		back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+	}
+
+	/**
+	 * Takes the newest published slot as the front slot, if one has been published since the last update.
+	 * Must only be called by the reader.
+	 * @return Boolean representing whether the front slot changed.
+	 */
+	template<typename T> bool triple_buffer<T>::update()
+	{
+		if((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+		{
+			return false;
+		}
+
+		front = middle.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+
+		return true;
+	}
+
+	/**
+	 * Gets the slot that the reader uses, which stays unchanged until the next update.
+	 * Must only be called by the reader.
+	 * @return The front slot.
+	 */
+	template<typename T> T& triple_buffer<T>::get_front()
+	{
+		return slots[front];
+	}
+}
+
+#endif /* INCLUDE_TRIPLE_BUFFER_H_ */
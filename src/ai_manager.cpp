@@ -2,104 +2,164 @@
 
 namespace villa
 {
+	const std::size_t ai_manager::DECISION_GRAIN;
+	const std::size_t ai_manager::DECISION_JOBS_PER_THREAD;
+
 	/**
 	 * Constructor for the Villager AI class.
 	 * @param simulation_map - The map of the simulation.
+	 * @param jobs - The job system to run villager decisions on.
+	 * @param seed - The seed for the random number streams.
 	 */
-	ai_manager::ai_manager(map* simulation_map, std::mt19937& rng) : simulation_map(simulation_map), rng(rng), timescale(1.0) { }
+	ai_manager::ai_manager(map* simulation_map, job_system* jobs, unsigned int seed) : simulation_map(simulation_map), jobs(jobs), seed(seed), tick(0) { }
 
 	/**
 	 * Executes the current task of each villager.
+	 * Villagers first decide in parallel, then the actions that change other entities are resolved in villager order.
+	 * @param tick - The current simulation tick.
 	 */
-	void ai_manager::think()
+	void ai_manager::think(unsigned long tick)
 	{
-		std::vector<villager*> villagers = simulation_map->get_villagers();
+		this->tick = tick;
+		slot_view<villager> villagers = simulation_map->get_villagers();
+		resolutions.assign(villagers.size(), 0);
+
+		// Split the villagers into a few jobs per thread so idle threads can pick up the remainder,
+		// but give each job enough villagers to be worth claiming
+		std::size_t job_count = jobs->get_thread_count() * DECISION_JOBS_PER_THREAD;
+		std::size_t grain = std::max(DECISION_GRAIN, (villagers.size() + job_count - 1) / job_count);
+
+		jobs->parallel_for(jobtype::villager_decision, villagers.size(), grain, [&](std::size_t index)
+		{
+			resolutions[index] = decide(villagers[index]);
+		});
 
 		// Loop through each villager in the vector
-		for(std::vector<villager*>::const_iterator iterator = villagers.begin(); iterator != villagers.end(); ++iterator)
+		for(std::size_t index = 0; index < villagers.size(); ++index)
 		{
-			task* current_task = (*iterator)->get_task();
-			taskdata data = current_task->get_data();
+			if(resolutions[index])
+			{
+				resolve(villagers[index]);
+			}
+		}
+	}
+
+	/**
+	 * Decides the next action of the villager and performs it if it only changes the villager.
+	 * May run concurrently with other villagers, so the rest of the map must only be read.
+	 * @param value - The villager.
+	 * @return Boolean representing whether the action changes other entities and must be resolved afterwards.
+	 */
+	bool ai_manager::decide(villager* value)
+	{
+		task* current_task = value->get_task();
+		taskdata data = current_task->get_data();
 
-			// If the villager is not within range to perform the target action,
-			// move until close enough before performing the action
-			// Ignore if the current task is to move, idle or build
-			if(!(*iterator)->is_at(data.target_coords.first, data.target_coords.second) && current_task->get_type() != tasktype::move && current_task->get_type() != tasktype::idle && current_task->get_type() != tasktype::build)
+		// If the villager is not within range to perform the target action,
+		// move until close enough before performing the action
+		// Ignore if the current task is to move, idle or build
+		if(!value->is_at(data.target_coords.first, data.target_coords.second) && current_task->get_type() != tasktype::move && current_task->get_type() != tasktype::idle && current_task->get_type() != tasktype::build)
+		{
+			// If the target is within a single tile distance, move directly towards it
+			if(abs(value->get_x() - data.target_coords.first) <= 16 && abs(value->get_y() - data.target_coords.second) <= 16)
+			{
+				value->add_task(new task(tasktype::move, taskdata(std::make_pair(data.target_coords.first, data.target_coords.second))));
+			}
+			else
 			{
-				// If the target is within a single tile distance, move directly towards it
-				if(abs((*iterator)->get_x() - data.target_coords.first) <= 16 && abs((*iterator)->get_y() - data.target_coords.second) <= 16)
+				std::vector<std::pair<int, int>> path = get_path(value->get_x(), value->get_y(), data.target_coords.first, data.target_coords.second);
+
+				// Check if there is a valid path to the target
+				if(!path.empty())
 				{
-					(*iterator)->add_task(new task(tasktype::move, taskdata(std::make_pair(data.target_coords.first, data.target_coords.second))));
+					// Add a move task for each point towards the target location
+					for(std::vector<std::pair<int, int>>::const_iterator it = path.begin(); it != path.end(); ++it)
+					{
+						value->add_task(new task(tasktype::move, taskdata(std::make_pair((it->first * 16) + 8, (it->second * 16) + 8))));
+					}
 				}
+				// If there is no valid path to the target, assume the task is invalid and remove it
 				else
 				{
-					std::vector<std::pair<int, int>> path = get_path((*iterator)->get_x(), (*iterator)->get_y(), data.target_coords.first, data.target_coords.second);
+					value->remove_task();
+				}
+			}
+		}
+		else
+		{
+			// Perform the appropriate action according to task type
+			switch(current_task->get_type())
+			{
+				case tasktype::idle : // Check current status and perform a new task
+					handle_task_idle(value);
+					break;
+
+				case tasktype::move : // Move towards the target coordinates
+					handle_task_move(value);
+					break;
 
-					// Check if there is a valid path to the target
-					if(!path.empty())
+				case tasktype::build : // Build a building, placing it once the villagers have decided
+					if(value->is_at(data.target_coords.first, data.target_coords.second))
 					{
-						// Add a move task for each point towards the target location
-						for(std::vector<std::pair<int, int>>::const_iterator it = path.begin(); it != path.end(); ++it)
-						{
-							(*iterator)->add_task(new task(tasktype::move, taskdata(std::make_pair((it->first * 16) + 8, (it->second * 16) + 8))));
-						}
+						return handle_task_build(value);
 					}
-					// If there is no valid path to the target, assume the task is invalid and remove it
 					else
 					{
-						(*iterator)->remove_task();
+						// The villager has left the building site (e.g. to gather materials), so abandon the building
+						delete data.target_building;
+						value->remove_task();
 					}
-				}
-			}
-			else
-			{
-				// Perform the appropriate action according to task type
-				switch(current_task->get_type())
-				{
-					case tasktype::idle : // Check current status and perform a new task
-						handle_task_idle(*iterator);
-						break;
+					break;
 
-					case tasktype::move : // Move towards the target coordinates
-						handle_task_move(*iterator);
+				case tasktype::harvest : // Take all the items from the target resource, resting between each harvest cycle
+					if(value->is_at(data.target_coords.first, data.target_coords.second))
+					{
+						handle_task_harvest(value);
 						break;
+					}
 
-					case tasktype::build : // Build a building
-						if((*iterator)->is_at(data.target_coords.first, data.target_coords.second))
-						{
-							handle_task_build(*iterator);
-							break;
-						}
+				case tasktype::take_item : // Take the item from the target entity once the villagers have decided
+				case tasktype::store_item : // Store the item into the target entity once the villagers have decided
+					if(value->is_at(data.target_coords.first, data.target_coords.second))
+					{
+						return true;
+					}
 
-					case tasktype::harvest : // Take all the items from the target resource, resting between each harvest cycle
-						if((*iterator)->is_at(data.target_coords.first, data.target_coords.second))
-						{
-							handle_task_harvest(*iterator);
-							break;
-						}
+				case tasktype::rest : // Wait until the set duration has passed
+					handle_task_rest(value);
+					break;
 
-					case tasktype::take_item : // Take the item from the target entity
-						if((*iterator)->is_at(data.target_coords.first, data.target_coords.second))
-						{
-							handle_task_take_item(*iterator);
-							break;
-						}
+				default:
+					break;
+			}
+		}
 
-					case tasktype::store_item : // Store the item into the target entity
-						if((*iterator)->is_at(data.target_coords.first, data.target_coords.second))
-						{
-							handle_task_store_item(*iterator);
-							break;
-						}
+		return false;
+	}
 
-					case tasktype::rest : // Wait until the set duration has passed
-						handle_task_rest(*iterator);
-						break;
+	/**
+	 * Performs the deferred action of the villager.
+	 * Runs on a single thread in villager order, so the action may change other entities.
+	 * @param value - The villager.
+	 */
+	void ai_manager::resolve(villager* value)
+	{
+		switch(value->get_task()->get_type())
+		{
+			case tasktype::build :
+				handle_task_build_complete(value);
+				break;
 
-					default:
-						break;
-				}
-			}
+			case tasktype::take_item :
+				handle_task_take_item(value);
+				break;
+
+			case tasktype::store_item :
+				handle_task_store_item(value);
+				break;
+
+			default:
+				break;
 		}
 	}
 
@@ -112,6 +172,8 @@ namespace villa
 		// Manage fatigue, hunger and thirst. If already handled, proceed with idle task.
 		if(!handle_villager_needs(value))
 		{
+			random_stream rng = get_random_stream(value, randompurpose::idle);
+
 			// Scale down random number while preserving uniform distribution
 			std::uniform_int_distribution<int> distribution(1, 100);
 			int target_action = distribution(rng);
@@ -123,7 +185,7 @@ namespace villa
 			}
 			else if(target_action <= 80) // Harvest the closest resource (50% chance)
 			{
-				std::vector<resource*> resources = simulation_map->get_resources();
+				slot_view<resource> resources = simulation_map->get_resources();
 				std::pair<int, resource*> target(9999, nullptr);
 
 				// Scale down random number while preserving uniform distribution
@@ -132,7 +194,7 @@ namespace villa
 				if(distribution(rng) == 1) // 25% chance to search for water resource
 				{
 					// Loop through each resource in the vector
-					for(std::vector<resource*>::const_iterator it = resources.begin(); it != resources.end(); ++it)
+					for(slot_view<resource>::iterator it = resources.begin(); it != resources.end(); ++it)
 					{
 						if((*it)->get_harvestable() == true && (*it)->get_type() == resourcetype::water)
 						{
@@ -149,7 +211,7 @@ namespace villa
 				else // 75% chance to search for resource that is not water
 				{
 					// Loop through each resource in the vector
-					for(std::vector<resource*>::const_iterator it = resources.begin(); it != resources.end(); ++it)
+					for(slot_view<resource>::iterator it = resources.begin(); it != resources.end(); ++it)
 					{
 						if((*it)->get_harvestable() == true && (*it)->get_type() != resourcetype::water)
 						{
@@ -179,11 +241,11 @@ namespace villa
 			{
 				if(value->get_inventory()->get_item_count() > 25)
 				{
-					std::vector<building*> buildings = simulation_map->get_buildings();
+					slot_view<building> buildings = simulation_map->get_buildings();
 					std::pair<int, building*> target(9999, nullptr);
 
 					// Loop through each building in the vector
-					for(std::vector<building*>::const_iterator it = buildings.begin(); it != buildings.end(); ++it)
+					for(slot_view<building>::iterator it = buildings.begin(); it != buildings.end(); ++it)
 					{
 						int distance = abs(value->get_x() - (*it)->get_x()) + abs(value->get_y() - (*it)->get_y());
 
@@ -281,7 +343,8 @@ namespace villa
 	{
 		taskdata data = value->get_task()->get_data();
 
-		value->move(data.target_coords.first, data.target_coords.second, timescale);
+		// Each tick covers a fixed step of time, so the villager always moves a single step
+		value->move(data.target_coords.first, data.target_coords.second, 1.0);
 
 		if(value->is_at(data.target_coords.first, data.target_coords.second))
 		{
@@ -291,83 +354,69 @@ namespace villa
 
 	/**
 	 * Handles the build task for the villager.
+	 * Gathers materials until the villager has enough to build.
 	 * @param value - The villager.
+	 * @return Boolean representing whether the villager is ready to place the building.
 	 */
-	void ai_manager::handle_task_build(villager* value)
+	bool ai_manager::handle_task_build(villager* value)
 	{
 		// Manage fatigue, hunger and thirst. If already handled, proceed with idle task.
 		if(!handle_villager_needs(value))
 		{
-			taskdata data = value->get_task()->get_data();
+			if(value->get_inventory()->get_item_count(itemtype::lumber) + value->get_inventory()->get_item_count(itemtype::stone) >= 40)
+			{
+				return true;
+			}
+
+			random_stream rng = get_random_stream(value, randompurpose::build);
 
 			// Scale down random number while preserving uniform distribution
 			std::uniform_int_distribution<int> distribution(1, 2);
 
-			if(value->get_inventory()->get_item_count(itemtype::lumber) + value->get_inventory()->get_item_count(itemtype::stone) >= 40)
+			if(distribution(rng) == 1 && value->get_inventory()->get_item_count(itemtype::lumber) < 20)
 			{
-				for(int i = 0; i < 20; ++i)
+				// Look for a building that contains lumber
+				std::pair<building*, item*> target_building = get_item_in_building(value->get_x(), value->get_y(), itemtype::lumber);
+
+				if(target_building.first != nullptr && target_building.second != nullptr)
 				{
-					value->get_inventory()->remove_item(itemtype::lumber);
-					value->get_inventory()->remove_item(itemtype::stone);
+					value->add_task(new task(tasktype::take_item, taskdata(std::make_pair(target_building.first->get_x(), target_building.first->get_y()), std::make_pair(target_building.first, target_building.second))));
 				}
-
-				simulation_map->add_building(data.target_building);
-				value->remove_task();
-				value->add_task(new task(tasktype::rest, taskdata(std::make_pair(data.target_building->get_x() + 8, data.target_building->get_y() + 16), 10000)));
-				value->set_hunger(value->get_hunger() + 5);
-				value->set_thirst(value->get_thirst() + 5);
-				value->set_fatigue(value->get_fatigue() + 5);
-
-				// Scale down random number while preserving uniform distribution
-				std::uniform_int_distribution<int> distribution_item(1, 4);
-				std::uniform_int_distribution<int> distribution_efficiency(1, 100);
-
-				// Add a random number of villagers at the new building
-				for(int count = 0; count < distribution(rng); ++count)
+				else // If no buildings contain lumber, look for a lumber resource
 				{
-					villager* target = new villager(data.target_building->get_x() + 8, data.target_building->get_y() + 16);
-					tool* target_tool = nullptr;
+					resource* target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::tree, rng);
 
-					switch(distribution_item(rng))
+					if(target_resource != nullptr)
 					{
-						case 1 :
-							target_tool = new tool(itemtype::axe, distribution_efficiency(rng));
-							break;
-
-						case 2 :
-							target_tool = new tool(itemtype::bucket, distribution_efficiency(rng));
-							break;
-
-						case 3 :
-							target_tool = new tool(itemtype::pickaxe, distribution_efficiency(rng));
-							break;
-
-						default :
-							break;
+						value->add_task(new task(tasktype::harvest, taskdata(std::make_pair(target_resource->get_x(), target_resource->get_y()), target_resource)));
 					}
-
-					if(target_tool != nullptr)
+					else
 					{
-						target->get_inventory()->add_item(target_tool);
+						value->add_task(new task(tasktype::rest, taskdata(std::make_pair(value->get_x(), value->get_y()), 2500)));
+						value->set_fatigue(value->get_fatigue() - 4);
 					}
-
-					simulation_map->add_villager(target);
 				}
 			}
-			else
+			else if(value->get_inventory()->get_item_count(itemtype::stone) < 20)
 			{
-				if(distribution(rng) == 1 && value->get_inventory()->get_item_count(itemtype::lumber) < 20)
+				// Look for a building that contains stone
+				std::pair<building*, item*> target_building = get_item_in_building(value->get_x(), value->get_y(), itemtype::stone);
+
+				if(target_building.first != nullptr && target_building.second != nullptr)
 				{
-					// Look for a building that contains lumber
-					std::pair<building*, item*> target_building = get_item_in_building(value->get_x(), value->get_y(), itemtype::lumber);
+					value->add_task(new task(tasktype::take_item, taskdata(std::make_pair(target_building.first->get_x(), target_building.first->get_y()), std::make_pair(target_building.first, target_building.second))));
+				}
+				else // If no buildings contain stone, look for a stone resource
+				{
+					resource* target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::stone, rng);
 
-					if(target_building.first != nullptr && target_building.second != nullptr)
+					if(target_resource != nullptr)
 					{
-						value->add_task(new task(tasktype::take_item, taskdata(std::make_pair(target_building.first->get_x(), target_building.first->get_y()), std::make_pair(target_building.first, target_building.second))));
+						value->add_task(new task(tasktype::harvest, taskdata(std::make_pair(target_resource->get_x(), target_resource->get_y()), target_resource)));
 					}
-					else // If no buildings contain lumber, look for a lumber resource
+					else
 					{
-						resource* target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::tree);
+						target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::ore, rng);
 
 						if(target_resource != nullptr)
 						{
@@ -380,40 +429,75 @@ namespace villa
 						}
 					}
 				}
-				else if(value->get_inventory()->get_item_count(itemtype::stone) < 20)
-				{
-					// Look for a building that contains stone
-					std::pair<building*, item*> target_building = get_item_in_building(value->get_x(), value->get_y(), itemtype::stone);
+			}
+		}
 
-					if(target_building.first != nullptr && target_building.second != nullptr)
-					{
-						value->add_task(new task(tasktype::take_item, taskdata(std::make_pair(target_building.first->get_x(), target_building.first->get_y()), std::make_pair(target_building.first, target_building.second))));
-					}
-					else // If no buildings contain stone, look for a stone resource
-					{
-						resource* target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::stone);
+		return false;
+	}
 
-						if(target_resource != nullptr)
-						{
-							value->add_task(new task(tasktype::harvest, taskdata(std::make_pair(target_resource->get_x(), target_resource->get_y()), target_resource)));
-						}
-						else
-						{
-							target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::ore);
+	/**
+	 * Places the building of the build task and spawns new villagers at it.
+	 * Adds entities to the map, so it is only called while resolving.
+	 * @param value - The villager.
+	 */
+	void ai_manager::handle_task_build_complete(villager* value)
+	{
+		taskdata data = value->get_task()->get_data();
+		random_stream rng = get_random_stream(value, randompurpose::build);
 
-							if(target_resource != nullptr)
-							{
-								value->add_task(new task(tasktype::harvest, taskdata(std::make_pair(target_resource->get_x(), target_resource->get_y()), target_resource)));
-							}
-							else
-							{
-								value->add_task(new task(tasktype::rest, taskdata(std::make_pair(value->get_x(), value->get_y()), 2500)));
-								value->set_fatigue(value->get_fatigue() - 4);
-							}
-						}
-					}
-				}
+		// Scale down random number while preserving uniform distribution
+		std::uniform_int_distribution<int> distribution(1, 2);
+
+		for(int i = 0; i < 20; ++i)
+		{
+			value->get_inventory()->remove_item(itemtype::lumber);
+			value->get_inventory()->remove_item(itemtype::stone);
+		}
+
+		// The building is placed once the villagers have been processed, so keep its entrance coords
+		int x = data.target_building->get_x() + 8, y = data.target_building->get_y() + 16;
+
+		simulation_map->get_commands()->add_building(data.target_building);
+		value->remove_task();
+		value->add_task(new task(tasktype::rest, taskdata(std::make_pair(x, y), 10000)));
+		value->set_hunger(value->get_hunger() + 5);
+		value->set_thirst(value->get_thirst() + 5);
+		value->set_fatigue(value->get_fatigue() + 5);
+
+		// Scale down random number while preserving uniform distribution
+		std::uniform_int_distribution<int> distribution_item(1, 4);
+		std::uniform_int_distribution<int> distribution_efficiency(1, 100);
+
+		// Add a random number of villagers at the new building
+		for(int count = 0; count < distribution(rng); ++count)
+		{
+			villager* target = new villager(x, y);
+			tool* target_tool = nullptr;
+
+			switch(distribution_item(rng))
+			{
+				case 1 :
+					target_tool = new tool(itemtype::axe, distribution_efficiency(rng));
+					break;
+
+				case 2 :
+					target_tool = new tool(itemtype::bucket, distribution_efficiency(rng));
+					break;
+
+				case 3 :
+					target_tool = new tool(itemtype::pickaxe, distribution_efficiency(rng));
+					break;
+
+				default :
+					break;
 			}
+
+			if(target_tool != nullptr)
+			{
+				target->get_inventory()->add_item(target_tool);
+			}
+
+			simulation_map->get_commands()->add_villager(target);
 		}
 	}
 
@@ -424,10 +508,12 @@ namespace villa
 	void ai_manager::handle_task_harvest(villager* value)
 	{
 		taskdata data = value->get_task()->get_data();
+		resource* target = simulation_map->get_resource(data.target_entity);
 
-		if(data.target_entity->get_inventory()->get_item_count() > 0)
+		// If the resource has been removed or has no items left, the task is no longer valid
+		if(target != nullptr && target->get_inventory()->get_item_count() > 0)
 		{
-			value->harvest();
+			value->harvest(target);
 		}
 		else
 		{
@@ -444,13 +530,24 @@ namespace villa
 		taskdata data = value->get_task()->get_data();
 
 		inventory* inv = value->get_inventory();
-		inventory* target_inv = data.target_item.first->get_inventory();
-
-		std::unique_ptr<item> target_item = target_inv->take_item(data.target_item.second);
+		entity* target = simulation_map->get_entity(data.target_type, data.target_item.first);
 
-		if(target_item.get() != nullptr)
+		// Only take the item if the target entity has not been removed
+		// The item is found by id, as it may have been taken by another villager since the task was added
+		if(target != nullptr)
 		{
-			inv->add_item(std::move(target_item));
+			std::unique_ptr<item> target_item = target->get_inventory()->take_item(target->get_inventory()->find_item(data.target_item.second));
+
+			if(target_item.get() != nullptr)
+			{
+				inv->add_item(std::move(target_item));
+
+				// The resource may have run out of items
+				if(data.target_type == entitytype::resource)
+				{
+					simulation_map->mark_resource_changed(static_cast<resource*>(target));
+				}
+			}
 		}
 
 		value->remove_task();
@@ -466,13 +563,17 @@ namespace villa
 		taskdata data = value->get_task()->get_data();
 
 		inventory* inv = value->get_inventory();
-		inventory* target_inv = data.target_item.first->get_inventory();
-
-		std::unique_ptr<item> target_item = inv->take_item(data.target_item.second);
+		entity* target = simulation_map->get_entity(data.target_type, data.target_item.first);
 
-		if(target_item.get() != nullptr)
+		// Only store the item if the target entity has not been removed
+		if(target != nullptr)
 		{
-			target_inv->add_item(std::move(target_item));
+			std::unique_ptr<item> target_item = inv->take_item(inv->find_item(data.target_item.second));
+
+			if(target_item.get() != nullptr)
+			{
+				target->get_inventory()->add_item(std::move(target_item));
+			}
 		}
 
 		value->remove_task();
@@ -485,6 +586,8 @@ namespace villa
 	 */
 	void ai_manager::handle_task_rest(villager* value)
 	{
+		random_stream rng = get_random_stream(value, randompurpose::rest);
+
 		// Scale down random number while preserving uniform distribution
 		std::uniform_int_distribution<int> distribution_chance(1, 600);
 
@@ -502,7 +605,7 @@ namespace villa
 			}
 		}
 
-		value->rest(timescale);
+		value->rest(1.0);
 	}
 
 	/**
@@ -511,6 +614,8 @@ namespace villa
 	 */
 	bool ai_manager::handle_villager_needs(villager* value)
 	{
+		random_stream rng = get_random_stream(value, randompurpose::needs);
+
 		// Scale down random number while preserving uniform distribution
 		std::uniform_int_distribution<int> distribution(1, 2);
 
@@ -542,7 +647,7 @@ namespace villa
 				}
 				else // If no buildings contain food, look for a food resource
 				{
-					resource* target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::food);
+					resource* target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::food, rng);
 
 					if(target_resource != nullptr)
 					{
@@ -578,7 +683,7 @@ namespace villa
 				}
 				else // If no buildings contain water, look for a water resource
 				{
-					resource* target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::water);
+					resource* target_resource = get_closest_resource(value->get_x(), value->get_y(), resourcetype::water, rng);
 
 					if(target_resource != nullptr)
 					{
@@ -607,23 +712,22 @@ namespace villa
 	 */
 	std::pair<building*, item*> ai_manager::get_item_in_building(int x, int y, itemtype type)
 	{
-		std::vector<building*> buildings = simulation_map->get_buildings();
 		std::pair<int, building*> target(9999, nullptr);
 
-		// Loop through each building in the vector for a food item
-		for(std::vector<building*>::const_iterator it = buildings.begin(); it != buildings.end(); ++it)
+		// Check each building on the map for the item type
+		simulation_map->for_each_building([&](building* value)
 		{
-			if((*it)->get_inventory()->get_item(type) != nullptr)
+			if(value->get_inventory()->get_item(type) != nullptr)
 			{
-				int distance = abs(x - (*it)->get_x()) + abs(y - (*it)->get_y());
+				int distance = abs(x - value->get_x()) + abs(y - value->get_y());
 
 				if(distance < target.first)
 				{
 					target.first = distance;
-					target.second = (*it);
+					target.second = value;
 				}
 			}
-		}
+		});
 
 		// If a target building containing the item type is found, return it
 		if(target.second != nullptr && target.second->get_inventory()->get_item(type) != nullptr)
@@ -639,30 +743,30 @@ namespace villa
 	 * @param x - The x-coords of the target.
 	 * @param y - The y-coords of the target.
 	 * @param type - The resource type to search for.
+	 * @param rng - The random number stream of the searching villager.
 	 * @return The closest resource to the target coords.
 	 */
-	resource* ai_manager::get_closest_resource(int x, int y, resourcetype type)
+	resource* ai_manager::get_closest_resource(int x, int y, resourcetype type, random_stream& rng)
 	{
-		std::vector<resource*> resources = simulation_map->get_resources();
 		std::pair<int, resource*> target(9999, nullptr);
 
 		// Scale down random number while preserving uniform distribution
 		std::uniform_int_distribution<int> distribution(1, 10);
 
-		// Loop through each resource in the vector
-		for(std::vector<resource*>::const_iterator it = resources.begin(); it != resources.end(); ++it)
+		// Check each resource on the map for the resource type
+		simulation_map->for_each_resource([&](resource* value)
 		{
-			if((*it)->get_type() == type && (*it)->get_harvestable() == true)
+			if(value->get_type() == type && value->get_harvestable() == true)
 			{
-				int distance = abs(x - (*it)->get_x()) + abs(y - (*it)->get_y()) + distribution(rng);
+				int distance = abs(x - value->get_x()) + abs(y - value->get_y()) + distribution(rng);
 
 				if(distance < target.first)
 				{
 					target.first = distance;
-					target.second = (*it);
+					target.second = value;
 				}
 			}
-		}
+		});
 
 		// If a target resource of the type is found, return it
 		if(target.second != nullptr)
@@ -681,11 +785,18 @@ namespace villa
 	 */
 	std::vector<std::pair<int, int>> ai_manager::get_path(int x, int y, int target_x, int target_y)
 	{
-		tile* start = simulation_map->get_tile_at(x / 16, y / 16);
-		tile* goal = simulation_map->get_tile_at(target_x / 16, target_y / 16);
-		std::unordered_map<tile*, tile*> came_from;
-		std::unordered_map<tile*, double> cost_so_far;
-		PriorityQueue<tile*, double> frontier;
+		// Tiles are identified by their index (x * 50 + y) rather than by pointer,
+		// so that ties in the frontier are always broken in the same order
+		if(simulation_map->get_tile_at(x / 16, y / 16) == nullptr || simulation_map->get_tile_at(target_x / 16, target_y / 16) == nullptr)
+		{
+			return std::vector<std::pair<int, int>>();
+		}
+
+		int start = (x / 16) * 50 + (y / 16);
+		int goal = (target_x / 16) * 50 + (target_y / 16);
+		std::vector<int> came_from(50 * 50, -1);
+		std::vector<double> cost_so_far(50 * 50, -1);
+		PriorityQueue<int, double> frontier;
 
 		frontier.put(start, 0);
 		came_from[start] = start;
@@ -694,36 +805,42 @@ namespace villa
 		// Keep searching until the the goal is found, or the entire map has been checked
 		while(!frontier.empty())
 		{
-			tile* current = frontier.get();
+			int current = frontier.get();
 
 			if(current == goal)
 			{
 				break;
 			}
 
-			std::pair<int, int> current_coords = simulation_map->get_tile_coords(current);
-			std::vector<tile*> neighbours = simulation_map->get_neighbour_tiles(current_coords.first, current_coords.second);
+			std::vector<std::pair<int, int>> neighbours = simulation_map->get_neighbour_coords(current / 50, current % 50);
 
 			// Check each neighbouring tile and calculate the movement cost
-			for(std::vector<tile*>::const_iterator it = neighbours.begin(); it != neighbours.end(); ++it )
+			for(std::vector<std::pair<int, int>>::const_iterator it = neighbours.begin(); it != neighbours.end(); ++it )
 			{
 				// The additional movement cost is lower if there's a road (1 vs 5)
 				// Additional movement cost is added for diagonal movement (1 vs 1.414)
 				// We use 1.414 (square root of two) as it represent the actual diagonal distance covered
+				int next = it->first * 50 + it->second;
 				double new_cost = (cost_so_far[current] + (it - neighbours.begin() < 4 ? 1 : 1.414));
-				if(!cost_so_far.count(*it) || new_cost < cost_so_far[*it])
+				if(cost_so_far[next] < 0 || new_cost < cost_so_far[next])
 				{
-					cost_so_far[*it] = new_cost;
+					cost_so_far[next] = new_cost;
 					double priority = new_cost + abs((x / 16) - (target_x / 16)) + abs((y / 16) - (target_y / 16));
-					frontier.put(*it, priority);
-					came_from[*it] = current;
+					frontier.put(next, priority);
+					came_from[next] = current;
 				}
 			}
 		}
 
+		// If the goal was never reached, there is no valid path
+		if(came_from[goal] == -1)
+		{
+			return std::vector<std::pair<int, int>>();
+		}
+
 		std::vector<std::pair<int, int>> path;
 		path.push_back(std::make_pair(target_x / 16, target_y / 16));
-		tile* current = goal;
+		int current = goal;
 		int count = 0;
 
 		// Get the path from the start to the goal by checking backwards from the goal tile
@@ -731,7 +848,7 @@ namespace villa
 		while(current != start && count < 200)
 		{
 			current = came_from[current];
-			path.push_back(simulation_map->get_tile_coords(current));
+			path.push_back(std::make_pair(current / 50, current % 50));
 			++count;
 		}
 
@@ -740,20 +857,14 @@ namespace villa
 	}
 
 	/**
-	 * Gets the time scale of the simulation.
-	 * @return The time scale multiplier.
-	 */
-	double ai_manager::get_timescale()
-	{
-		return this->timescale;
-	}
-
-	/**
-	 * Sets the time scale of the simulation.
-	 * @param value - The time scale multiplier.
+	 * Gets the random number stream for a decision made by the villager during the current tick.
+	 * The stream only depends on the villager, tick and purpose, so villagers can think in any order.
+	 * @param value - The villager.
+	 * @param purpose - The kind of decision being made.
+	 * @return The random number stream.
 	 */
-	void ai_manager::set_timescale(double value)
+	random_stream ai_manager::get_random_stream(villager* value, randompurpose purpose)
 	{
-		this->timescale = value;
+		return random_stream(seed, tick, value->get_handle(), purpose);
 	}
 }
@@ -1,17 +1,31 @@
 #include "app.hpp"
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
 namespace villa
 {
 	/**
 	 * Constructor for the App class.
+	 * @param options - The application options.
 	 */
-	app::app() : window(nullptr), renderer(nullptr)
+	app::app(option_struct options) : options(options), textures(), fonts(), hud(), simulation_camera(800, 800, 50 * 16, 50 * 16), display_dirty(true), terrain_dirty(true), terrain_version(0), window(nullptr), renderer(nullptr)
 	{
+		for(int i = 0; i < TERRAIN_CHUNKS; ++i)
+		{
+			for(int j = 0; j < TERRAIN_CHUNKS; ++j)
+			{
+				terrain_chunks[i][j] = nullptr;
+			}
+		}
+
 		// Set initial state to exit
 		state.push(appstate::exit);
-
-		// Seed the random number generator
-		rng.seed(time(nullptr));
 	}
 
 	/**
@@ -19,6 +33,8 @@ namespace villa
 	 */
 	app::~app()
 	{
+		destroy_simulation_terrain();
+
 		SDL_DestroyRenderer(renderer);
 		SDL_DestroyWindow(window);
 
@@ -32,7 +48,7 @@ namespace villa
 
 	/**
 	 * Starts the application.
-	 * Contains the application loop and all simulation logic.
+	 * Contains the application loop, which displays the simulation while it runs on its own thread.
 	 */
 	void app::start()
 	{
@@ -47,9 +63,13 @@ namespace villa
 			state.push(appstate::menu_main);
 
 			// Initialize time-related variables
-			const int UPDATE_TIME = 1000 / 60;
-			unsigned int accumulator = 0;
 			timers.timescale = 1.0;
+			timers.fast_forward = false;
+			timers.usage_report = timers.app = SDL_GetTicks();
+			timers.usage_cpu = get_cpu_time();
+			timers.frames = 0;
+			double cpu_start = timers.usage_cpu;
+			unsigned int wall_start = timers.app;
 
 			// Hide the default cursor
 			SDL_ShowCursor(0);
@@ -57,26 +77,30 @@ namespace villa
 			// Loop until the user exits the application
 			while(state.top() != appstate::exit)
 			{
-				accumulator += SDL_GetTicks() - timers.app;
-				timers.app = SDL_GetTicks();
-
-				while(accumulator >= UPDATE_TIME)
-				{
-					handle_input();
+				unsigned int frame_start = SDL_GetTicks();
 
-					// If running the simulation, update the AI
-					if(state.top() == appstate::simulation)
-					{
-						update_simulation();
-						simulation_ai->set_timescale(timers.timescale);
-						simulation_ai->think();
-					}
+				handle_input();
 
-					accumulator -= UPDATE_TIME;
-					timers.simulation_time += UPDATE_TIME * timers.timescale;
+				// The simulation runs on its own thread, so each frame displays its newest snapshot
+				if(simulation_state != nullptr)
+				{
+					update_simulation();
 				}
 
+				update_tick_rate();
+				update_usage();
 				update_display();
+				wait_for_frame(frame_start);
+			}
+
+			double wall_seconds = (SDL_GetTicks() - wall_start) / 1000.0;
+			double cpu_seconds = get_cpu_time() - cpu_start;
+			std::cout << "Average CPU usage: " << (int)(wall_seconds > 0 ? cpu_seconds * 100 / wall_seconds : 0) << "%" << std::endl;
+
+			if(simulation_state != nullptr)
+			{
+				simulation_state->stop();
+				print_job_stats();
 			}
 
 			std::cout << "Exiting application..." << std::endl;
@@ -113,7 +137,7 @@ namespace villa
 		std::cout << "Application window successfully initialized." << std::endl;
 
 		// Initialize the 2D renderer
-		renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+		renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | (options.vsync ? SDL_RENDERER_PRESENTVSYNC : 0));
 
 		// Check if the 2D renderer initializes successfully
 		if(renderer == nullptr || SDL_RenderSetLogicalSize(renderer, 800, 800) != 0)
@@ -148,6 +172,8 @@ namespace villa
 
 		std::cout << "TTF Loader successfully initialized." << std::endl;
 
+		std::cout << "Villager needs kernel: " << needs_batch::get_kernel_name(needs_batch::get_kernel_best()) << std::endl;
+
 		std::cout << "Application instance successfully initialized." << std::endl;
 
 		return true;
@@ -159,177 +185,212 @@ namespace villa
 	void app::load_resources()
 	{
 		// Load background image
-		resources->load_texture("background", "assets/images/background.png");
+		textures.background = resources->load_texture("background", "assets/images/background.png");
 
 		// Load tile images
-		resources->load_texture("grass_c", "assets/images/tiles/grass_c.png");
-
-		resources->load_texture("water_nw", "assets/images/tiles/water_nw.png");
-		resources->load_texture("water_n", "assets/images/tiles/water_n.png");
-		resources->load_texture("water_ne", "assets/images/tiles/water_ne.png");
-		resources->load_texture("water_w", "assets/images/tiles/water_w.png");
-		resources->load_texture("water_c", "assets/images/tiles/water_c.png");
-		resources->load_texture("water_e", "assets/images/tiles/water_e.png");
-		resources->load_texture("water_sw", "assets/images/tiles/water_sw.png");
-		resources->load_texture("water_s", "assets/images/tiles/water_s.png");
-		resources->load_texture("water_se", "assets/images/tiles/water_se.png");
-
-		resources->load_texture("water_corner_nw", "assets/images/tiles/water_corner_nw.png");
-		resources->load_texture("water_corner_ne", "assets/images/tiles/water_corner_ne.png");
-		resources->load_texture("water_corner_sw", "assets/images/tiles/water_corner_sw.png");
-		resources->load_texture("water_corner_se", "assets/images/tiles/water_corner_se.png");
-
-		resources->load_texture("dirt_nw", "assets/images/tiles/dirt_nw.png");
-		resources->load_texture("dirt_n", "assets/images/tiles/dirt_n.png");
-		resources->load_texture("dirt_ne", "assets/images/tiles/dirt_ne.png");
-		resources->load_texture("dirt_w", "assets/images/tiles/dirt_w.png");
-		resources->load_texture("dirt_c", "assets/images/tiles/dirt_c.png");
-		resources->load_texture("dirt_e", "assets/images/tiles/dirt_e.png");
-		resources->load_texture("dirt_sw", "assets/images/tiles/dirt_sw.png");
-		resources->load_texture("dirt_s", "assets/images/tiles/dirt_s.png");
-		resources->load_texture("dirt_se", "assets/images/tiles/dirt_se.png");
-
-		resources->load_texture("dirt_corner_nw", "assets/images/tiles/dirt_corner_nw.png");
-		resources->load_texture("dirt_corner_ne", "assets/images/tiles/dirt_corner_ne.png");
-		resources->load_texture("dirt_corner_sw", "assets/images/tiles/dirt_corner_sw.png");
-		resources->load_texture("dirt_corner_se", "assets/images/tiles/dirt_corner_se.png");
-
-		resources->load_texture("sand_nw", "assets/images/tiles/sand_nw.png");
-		resources->load_texture("sand_n", "assets/images/tiles/sand_n.png");
-		resources->load_texture("sand_ne", "assets/images/tiles/sand_ne.png");
-		resources->load_texture("sand_w", "assets/images/tiles/sand_w.png");
-		resources->load_texture("sand_c", "assets/images/tiles/sand_c.png");
-		resources->load_texture("sand_e", "assets/images/tiles/sand_e.png");
-		resources->load_texture("sand_sw", "assets/images/tiles/sand_sw.png");
-		resources->load_texture("sand_s", "assets/images/tiles/sand_s.png");
-		resources->load_texture("sand_se", "assets/images/tiles/sand_se.png");
-
-		resources->load_texture("sand_corner_nw", "assets/images/tiles/sand_corner_nw.png");
-		resources->load_texture("sand_corner_ne", "assets/images/tiles/sand_corner_ne.png");
-		resources->load_texture("sand_corner_sw", "assets/images/tiles/sand_corner_sw.png");
-		resources->load_texture("sand_corner_se", "assets/images/tiles/sand_corner_se.png");
-
-		resources->load_texture("stone_nw", "assets/images/tiles/stone_nw.png");
-		resources->load_texture("stone_n", "assets/images/tiles/stone_n.png");
-		resources->load_texture("stone_ne", "assets/images/tiles/stone_ne.png");
-		resources->load_texture("stone_w", "assets/images/tiles/stone_w.png");
-		resources->load_texture("stone_c", "assets/images/tiles/stone_c.png");
-		resources->load_texture("stone_e", "assets/images/tiles/stone_e.png");
-		resources->load_texture("stone_sw", "assets/images/tiles/stone_sw.png");
-		resources->load_texture("stone_s", "assets/images/tiles/stone_s.png");
-		resources->load_texture("stone_se", "assets/images/tiles/stone_se.png");
-
-		resources->load_texture("stone_corner_nw", "assets/images/tiles/stone_corner_nw.png");
-		resources->load_texture("stone_corner_ne", "assets/images/tiles/stone_corner_ne.png");
-		resources->load_texture("stone_corner_sw", "assets/images/tiles/stone_corner_sw.png");
-		resources->load_texture("stone_corner_se", "assets/images/tiles/stone_corner_se.png");
+		textures.grass_c = resources->load_texture("grass_c", "assets/images/tiles/grass_c.png");
+
+		load_tileset(textures.water, "water");
+		load_tileset(textures.dirt, "dirt");
+		load_tileset(textures.sand, "sand");
+		load_tileset(textures.stone, "stone");
 
 		// Load building images
-		resources->load_texture("door_small", "assets/images/buildings/door_small.png");
-		resources->load_texture("door_small_alt", "assets/images/buildings/door_small_alt.png");
-		resources->load_texture("roof_small_front", "assets/images/buildings/roof_small_front.png");
-		resources->load_texture("roof_small_back", "assets/images/buildings/roof_small_back.png");
-		resources->load_texture("wall_small_base", "assets/images/buildings/wall_small_base.png");
-
-		resources->load_texture("door_large1", "assets/images/buildings/door_large1.png");
-		resources->load_texture("door_large2", "assets/images/buildings/door_large2.png");
-		resources->load_texture("roof_large_front1", "assets/images/buildings/roof_large_front1.png");
-		resources->load_texture("roof_large_front2", "assets/images/buildings/roof_large_front2.png");
-		resources->load_texture("roof_large_front1_alt", "assets/images/buildings/roof_large_front1_alt.png");
-		resources->load_texture("roof_large_front2_alt", "assets/images/buildings/roof_large_front2_alt.png");
-		resources->load_texture("roof_large_middle1", "assets/images/buildings/roof_large_middle1.png");
-		resources->load_texture("roof_large_middle2", "assets/images/buildings/roof_large_middle2.png");
-		resources->load_texture("roof_large_back1", "assets/images/buildings/roof_large_back1.png");
-		resources->load_texture("roof_large_back2", "assets/images/buildings/roof_large_back2.png");
-		resources->load_texture("roof_large_back1_alt", "assets/images/buildings/roof_large_back1_alt.png");
-		resources->load_texture("roof_large_back2_alt", "assets/images/buildings/roof_large_back2_alt.png");
-		resources->load_texture("wall_large_middle1", "assets/images/buildings/wall_large_middle1.png");
-		resources->load_texture("wall_large_middle2", "assets/images/buildings/wall_large_middle2.png");
-		resources->load_texture("wall_large_base1", "assets/images/buildings/wall_large_base1.png");
-		resources->load_texture("wall_large_base2", "assets/images/buildings/wall_large_base2.png");
-
-		resources->load_texture("blacksmith_forge", "assets/images/buildings/blacksmith_forge.png");
-		resources->load_texture("roof_flat_back1", "assets/images/buildings/roof_flat_back1.png");
-		resources->load_texture("roof_flat_back2", "assets/images/buildings/roof_flat_back2.png");
-
-		resources->load_texture("stall_roof1", "assets/images/buildings/stall_roof1.png");
-		resources->load_texture("stall_roof2", "assets/images/buildings/stall_roof2.png");
-		resources->load_texture("stall_roof1_alt", "assets/images/buildings/stall_roof1_alt.png");
-		resources->load_texture("stall_roof2_alt", "assets/images/buildings/stall_roof2_alt.png");
-		resources->load_texture("stall_base1", "assets/images/buildings/stall_base1.png");
-		resources->load_texture("stall_base2", "assets/images/buildings/stall_base2.png");
-		resources->load_texture("stall_base1_alt", "assets/images/buildings/stall_base1_alt.png");
-		resources->load_texture("stall_base2_alt", "assets/images/buildings/stall_base2_alt.png");
+		textures.door_small = resources->load_texture("door_small", "assets/images/buildings/door_small.png");
+		textures.door_small_alt = resources->load_texture("door_small_alt", "assets/images/buildings/door_small_alt.png");
+		textures.roof_small_front = resources->load_texture("roof_small_front", "assets/images/buildings/roof_small_front.png");
+		textures.roof_small_back = resources->load_texture("roof_small_back", "assets/images/buildings/roof_small_back.png");
+		textures.wall_small_base = resources->load_texture("wall_small_base", "assets/images/buildings/wall_small_base.png");
+
+		textures.door_large1 = resources->load_texture("door_large1", "assets/images/buildings/door_large1.png");
+		textures.door_large2 = resources->load_texture("door_large2", "assets/images/buildings/door_large2.png");
+		textures.roof_large_front1 = resources->load_texture("roof_large_front1", "assets/images/buildings/roof_large_front1.png");
+		textures.roof_large_front2 = resources->load_texture("roof_large_front2", "assets/images/buildings/roof_large_front2.png");
+		textures.roof_large_front1_alt = resources->load_texture("roof_large_front1_alt", "assets/images/buildings/roof_large_front1_alt.png");
+		textures.roof_large_front2_alt = resources->load_texture("roof_large_front2_alt", "assets/images/buildings/roof_large_front2_alt.png");
+		textures.roof_large_middle1 = resources->load_texture("roof_large_middle1", "assets/images/buildings/roof_large_middle1.png");
+		textures.roof_large_middle2 = resources->load_texture("roof_large_middle2", "assets/images/buildings/roof_large_middle2.png");
+		textures.roof_large_back1 = resources->load_texture("roof_large_back1", "assets/images/buildings/roof_large_back1.png");
+		textures.roof_large_back2 = resources->load_texture("roof_large_back2", "assets/images/buildings/roof_large_back2.png");
+		textures.roof_large_back1_alt = resources->load_texture("roof_large_back1_alt", "assets/images/buildings/roof_large_back1_alt.png");
+		textures.roof_large_back2_alt = resources->load_texture("roof_large_back2_alt", "assets/images/buildings/roof_large_back2_alt.png");
+		textures.wall_large_middle1 = resources->load_texture("wall_large_middle1", "assets/images/buildings/wall_large_middle1.png");
+		textures.wall_large_middle2 = resources->load_texture("wall_large_middle2", "assets/images/buildings/wall_large_middle2.png");
+		textures.wall_large_base1 = resources->load_texture("wall_large_base1", "assets/images/buildings/wall_large_base1.png");
+		textures.wall_large_base2 = resources->load_texture("wall_large_base2", "assets/images/buildings/wall_large_base2.png");
+
+		textures.blacksmith_forge = resources->load_texture("blacksmith_forge", "assets/images/buildings/blacksmith_forge.png");
+		textures.roof_flat_back1 = resources->load_texture("roof_flat_back1", "assets/images/buildings/roof_flat_back1.png");
+		textures.roof_flat_back2 = resources->load_texture("roof_flat_back2", "assets/images/buildings/roof_flat_back2.png");
+
+		textures.stall_roof1 = resources->load_texture("stall_roof1", "assets/images/buildings/stall_roof1.png");
+		textures.stall_roof2 = resources->load_texture("stall_roof2", "assets/images/buildings/stall_roof2.png");
+		textures.stall_roof1_alt = resources->load_texture("stall_roof1_alt", "assets/images/buildings/stall_roof1_alt.png");
+		textures.stall_roof2_alt = resources->load_texture("stall_roof2_alt", "assets/images/buildings/stall_roof2_alt.png");
+		textures.stall_base1 = resources->load_texture("stall_base1", "assets/images/buildings/stall_base1.png");
+		textures.stall_base2 = resources->load_texture("stall_base2", "assets/images/buildings/stall_base2.png");
+		textures.stall_base1_alt = resources->load_texture("stall_base1_alt", "assets/images/buildings/stall_base1_alt.png");
+		textures.stall_base2_alt = resources->load_texture("stall_base2_alt", "assets/images/buildings/stall_base2_alt.png");
 
 		// Load resource images
-		resources->load_texture("food_1", "assets/images/resources/food_1.png");
-		resources->load_texture("food_2", "assets/images/resources/food_2.png");
-		resources->load_texture("food_3", "assets/images/resources/food_3.png");
-		resources->load_texture("food_harvested", "assets/images/resources/food_harvested.png");
-
-		resources->load_texture("ore_1", "assets/images/resources/ore_1.png");
-		resources->load_texture("ore_2", "assets/images/resources/ore_2.png");
-		resources->load_texture("ore_3", "assets/images/resources/ore_3.png");
-		resources->load_texture("ore_4", "assets/images/resources/ore_4.png");
-		resources->load_texture("ore_5", "assets/images/resources/ore_5.png");
-		resources->load_texture("ore_6", "assets/images/resources/ore_6.png");
-
-		resources->load_texture("stone_1", "assets/images/resources/stone_1.png");
-		resources->load_texture("stone_2", "assets/images/resources/stone_2.png");
-		resources->load_texture("stone_3", "assets/images/resources/stone_3.png");
-		resources->load_texture("stone_4", "assets/images/resources/stone_4.png");
-		resources->load_texture("stone_5", "assets/images/resources/stone_5.png");
-		resources->load_texture("stone_6", "assets/images/resources/stone_6.png");
-
-		resources->load_texture("tree_small", "assets/images/resources/tree_small.png");
-		resources->load_texture("tree_small_harvested", "assets/images/resources/tree_small_harvested.png");
-		resources->load_texture("tree_top", "assets/images/resources/tree_top.png");
-		resources->load_texture("tree_top_alt", "assets/images/resources/tree_top_alt.png");
-		resources->load_texture("tree_top_harvested", "assets/images/resources/tree_top_harvested.png");
-		resources->load_texture("tree_bottom", "assets/images/resources/tree_bottom.png");
-		resources->load_texture("tree_bottom_alt", "assets/images/resources/tree_bottom_alt.png");
-		resources->load_texture("tree_bottom_harvested", "assets/images/resources/tree_bottom_harvested.png");
-
-		resources->load_texture("grave_1", "assets/images/resources/grave_1.png");
-		resources->load_texture("grave_2", "assets/images/resources/grave_2.png");
-		resources->load_texture("grave_3", "assets/images/resources/grave_3.png");
+		textures.food_1 = resources->load_texture("food_1", "assets/images/resources/food_1.png");
+		textures.food_2 = resources->load_texture("food_2", "assets/images/resources/food_2.png");
+		textures.food_3 = resources->load_texture("food_3", "assets/images/resources/food_3.png");
+		textures.food_harvested = resources->load_texture("food_harvested", "assets/images/resources/food_harvested.png");
+
+		textures.ore_1 = resources->load_texture("ore_1", "assets/images/resources/ore_1.png");
+		textures.ore_2 = resources->load_texture("ore_2", "assets/images/resources/ore_2.png");
+		textures.ore_3 = resources->load_texture("ore_3", "assets/images/resources/ore_3.png");
+		textures.ore_4 = resources->load_texture("ore_4", "assets/images/resources/ore_4.png");
+		textures.ore_5 = resources->load_texture("ore_5", "assets/images/resources/ore_5.png");
+		textures.ore_6 = resources->load_texture("ore_6", "assets/images/resources/ore_6.png");
+
+		textures.stone_1 = resources->load_texture("stone_1", "assets/images/resources/stone_1.png");
+		textures.stone_2 = resources->load_texture("stone_2", "assets/images/resources/stone_2.png");
+		textures.stone_3 = resources->load_texture("stone_3", "assets/images/resources/stone_3.png");
+		textures.stone_4 = resources->load_texture("stone_4", "assets/images/resources/stone_4.png");
+		textures.stone_5 = resources->load_texture("stone_5", "assets/images/resources/stone_5.png");
+		textures.stone_6 = resources->load_texture("stone_6", "assets/images/resources/stone_6.png");
+
+		textures.tree_small = resources->load_texture("tree_small", "assets/images/resources/tree_small.png");
+		textures.tree_small_harvested = resources->load_texture("tree_small_harvested", "assets/images/resources/tree_small_harvested.png");
+		textures.tree_top = resources->load_texture("tree_top", "assets/images/resources/tree_top.png");
+		textures.tree_top_alt = resources->load_texture("tree_top_alt", "assets/images/resources/tree_top_alt.png");
+		textures.tree_top_harvested = resources->load_texture("tree_top_harvested", "assets/images/resources/tree_top_harvested.png");
+		textures.tree_bottom = resources->load_texture("tree_bottom", "assets/images/resources/tree_bottom.png");
+		textures.tree_bottom_alt = resources->load_texture("tree_bottom_alt", "assets/images/resources/tree_bottom_alt.png");
+		textures.tree_bottom_harvested = resources->load_texture("tree_bottom_harvested", "assets/images/resources/tree_bottom_harvested.png");
+
+		textures.grave_1 = resources->load_texture("grave_1", "assets/images/resources/grave_1.png");
+		textures.grave_2 = resources->load_texture("grave_2", "assets/images/resources/grave_2.png");
+		textures.grave_3 = resources->load_texture("grave_3", "assets/images/resources/grave_3.png");
 
 		// Load entity images
-		resources->load_texture("villager", "assets/images/entities/villager.png");
-		resources->load_texture("villager_alt", "assets/images/entities/villager_alt.png");
-		resources->load_texture("villager_alt2", "assets/images/entities/villager_alt2.png");
-		resources->load_texture("villager_alt3", "assets/images/entities/villager_alt3.png");
+		textures.villager = resources->load_texture("villager", "assets/images/entities/villager.png");
+		textures.villager_alt = resources->load_texture("villager_alt", "assets/images/entities/villager_alt.png");
+		textures.villager_alt2 = resources->load_texture("villager_alt2", "assets/images/entities/villager_alt2.png");
+		textures.villager_alt3 = resources->load_texture("villager_alt3", "assets/images/entities/villager_alt3.png");
+
+		// Compose the multi-part buildings and resources from their images
+		compose_resources();
+
+		// Pack the tile, resource and entity images into atlas textures, created before linear texture filtering is enabled
+		resources->build_atlas();
 
 		// Enable linear texture filtering when loading UI elements
 		// Not used for tile-based textures due to rendering artifacts (black lines, random gaps)
 		SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
 
 		// Load UI images
-		resources->load_texture("cursor", "assets/images/ui/cursorHand_grey.png");
-		resources->load_texture("iconMenu_brown", "assets/images/ui/iconMenu_brown.png");
-		resources->load_texture("iconCross_brown", "assets/images/ui/iconCross_brown.png");
-		resources->load_texture("arrowBeige_left", "assets/images/ui/arrowBeige_left.png");
-		resources->load_texture("arrowBeige_right", "assets/images/ui/arrowBeige_right.png");
-		resources->load_texture("buttonRound_brown", "assets/images/ui/buttonRound_brown.png");
-		resources->load_texture("buttonLong_brown", "assets/images/ui/buttonLong_brown.png");
-		resources->load_texture("buttonLong_brown_pressed", "assets/images/ui/buttonLong_brown_pressed.png");
-		resources->load_texture("menuBar_brown", "assets/images/ui/menuBar_brown.png");
-
-		resources->load_texture("label_building", "assets/images/ui/label_building.png");
-		resources->load_texture("label_food", "assets/images/ui/label_food.png");
-		resources->load_texture("label_grave", "assets/images/ui/label_grave.png");
-		resources->load_texture("label_ore", "assets/images/ui/label_ore.png");
-		resources->load_texture("label_stone", "assets/images/ui/label_stone.png");
-		resources->load_texture("label_tree", "assets/images/ui/label_tree.png");
-		resources->load_texture("label_villager", "assets/images/ui/label_villager.png");
+		textures.cursor = resources->load_texture("cursor", "assets/images/ui/cursorHand_grey.png");
+		textures.iconMenu_brown = resources->load_texture("iconMenu_brown", "assets/images/ui/iconMenu_brown.png");
+		textures.iconCross_brown = resources->load_texture("iconCross_brown", "assets/images/ui/iconCross_brown.png");
+		textures.arrowBeige_left = resources->load_texture("arrowBeige_left", "assets/images/ui/arrowBeige_left.png");
+		textures.arrowBeige_right = resources->load_texture("arrowBeige_right", "assets/images/ui/arrowBeige_right.png");
+		textures.buttonRound_brown = resources->load_texture("buttonRound_brown", "assets/images/ui/buttonRound_brown.png");
+		textures.buttonLong_brown = resources->load_texture("buttonLong_brown", "assets/images/ui/buttonLong_brown.png");
+		textures.buttonLong_brown_pressed = resources->load_texture("buttonLong_brown_pressed", "assets/images/ui/buttonLong_brown_pressed.png");
+		textures.menuBar_brown = resources->load_texture("menuBar_brown", "assets/images/ui/menuBar_brown.png");
+
+		textures.label_building = resources->load_texture("label_building", "assets/images/ui/label_building.png");
+		textures.label_food = resources->load_texture("label_food", "assets/images/ui/label_food.png");
+		textures.label_grave = resources->load_texture("label_grave", "assets/images/ui/label_grave.png");
+		textures.label_ore = resources->load_texture("label_ore", "assets/images/ui/label_ore.png");
+		textures.label_stone = resources->load_texture("label_stone", "assets/images/ui/label_stone.png");
+		textures.label_tree = resources->load_texture("label_tree", "assets/images/ui/label_tree.png");
+		textures.label_villager = resources->load_texture("label_villager", "assets/images/ui/label_villager.png");
+
+		// Pack the UI images into their own atlas textures, created with linear texture filtering
+		resources->build_atlas();
 
 		SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
 
 		// Load fonts
-		resources->load_font("KenPixel Blocks", "assets/fonts/kenpixel_blocks.ttf", 160);
-		resources->load_font("KenPixel Square", "assets/fonts/kenpixel_square.ttf", 24);
-		resources->load_font("KenPixel Square Medium", "assets/fonts/kenpixel_square.ttf", 20);
-		resources->load_font("KenPixel Square Small", "assets/fonts/kenpixel_square.ttf", 14);
+		fonts.blocks = resources->load_font("KenPixel Blocks", "assets/fonts/kenpixel_blocks.ttf", 160);
+		fonts.square = resources->load_font("KenPixel Square", "assets/fonts/kenpixel_square.ttf", 24);
+		fonts.square_medium = resources->load_font("KenPixel Square Medium", "assets/fonts/kenpixel_square.ttf", 20);
+		fonts.square_small = resources->load_font("KenPixel Square Small", "assets/fonts/kenpixel_square.ttf", 14);
+	}
+
+	/**
+	 * Loads the textures of a tile type for each tile variant.
+	 * Textures must be named using the following formats :
+	 * 1. (filename)_(direction).png
+	 * 2. (filename)_corner_(direction).png
+	 *
+	 * Directions are declared as the first letters of north, south, east or west.
+	 * Two combinations of letters can be used to specify diagonal directions.
+	 * Example : texture_nw.png, texture_corner_nw.png
+	 *
+	 * @param tileset - The tileset to load the textures into.
+	 * @param name - The name of the textures (without direction).
+	 */
+	void app::load_tileset(tileset_struct& tileset, std::string name)
+	{
+		// The texture suffix of each tile variant, in the order of the tile variant enumeration
+		const std::string suffixes[tile::variant_count] = {"c", "n", "ne", "e", "se", "s", "sw", "w", "nw", "corner_ne", "corner_nw", "corner_se", "corner_sw"};
+
+		for(int i = 0; i < tile::variant_count; ++i)
+		{
+			tileset.variants[i] = resources->load_texture(name + "_" + suffixes[i], "assets/images/tiles/" + name + "_" + suffixes[i] + ".png");
+		}
+	}
+
+	/**
+	 * Composes each building and multi-part resource into a single texture, so that each is drawn with a single blit.
+	 * Large buildings are drawn from 64 pixels above their position, small buildings and trees from 32 pixels above.
+	 */
+	void app::compose_resources()
+	{
+		textures.town_hall = resources->compose_texture("town_hall", {
+			{textures.wall_large_base1, 0, 48}, {textures.wall_large_base2, 16, 48},
+			{textures.wall_large_middle1, 0, 32}, {textures.wall_large_middle2, 16, 32},
+			{textures.roof_large_back1, 0, 0}, {textures.roof_large_back2, 16, 0},
+			{textures.roof_large_middle1, 0, 16}, {textures.roof_large_middle2, 16, 16},
+			{textures.roof_large_front1, 0, 32}, {textures.roof_large_front2, 16, 32},
+			{textures.door_large1, 0, 48}, {textures.door_large2, 16, 48}
+		});
+
+		textures.house = resources->compose_texture("house", {
+			{textures.wall_large_base1, 0, 48}, {textures.wall_large_base2, 16, 48},
+			{textures.wall_large_middle1, 0, 32}, {textures.wall_large_middle2, 16, 32},
+			{textures.roof_large_back1, 0, 0}, {textures.roof_large_back2, 16, 0},
+			{textures.roof_large_middle1, 0, 16}, {textures.roof_large_middle2, 16, 16},
+			{textures.roof_large_front1, 0, 32}, {textures.roof_large_front2, 16, 32},
+			{textures.door_small, 8, 48}
+		});
+
+		textures.house_small = resources->compose_texture("house_small", {
+			{textures.wall_small_base, 0, 16}, {textures.roof_small_back, 0, 0}, {textures.roof_small_front, 0, 8}
+		});
+
+		textures.farmhouse = resources->compose_texture("farmhouse", {
+			{textures.wall_large_base1, 0, 48}, {textures.wall_large_base2, 16, 48},
+			{textures.wall_large_middle1, 0, 32}, {textures.wall_large_middle2, 16, 32},
+			{textures.roof_large_back1_alt, 0, 0}, {textures.roof_large_back2_alt, 16, 0},
+			{textures.roof_large_middle1, 0, 16}, {textures.roof_large_middle2, 16, 16},
+			{textures.roof_large_front1_alt, 0, 32}, {textures.roof_large_front2_alt, 16, 32},
+			{textures.door_small_alt, 8, 48}
+		});
+
+		textures.blacksmith = resources->compose_texture("blacksmith", {
+			{textures.wall_large_base1, 0, 16}, {textures.wall_large_base2, 16, 16},
+			{textures.roof_flat_back1, 0, 0}, {textures.roof_flat_back2, 16, 0},
+			{textures.blacksmith_forge, 8, 16}
+		});
+
+		// Stall variants 0 and 1 use the plain base, and variants 0 and 2 use the plain roof
+		for(int i = 0; i < 4; ++i)
+		{
+			textures.stall[i] = resources->compose_texture("stall" + std::to_string(i), {
+				{i <= 1 ? textures.stall_base1 : textures.stall_base1_alt, 0, 16}, {i <= 1 ? textures.stall_base2 : textures.stall_base2_alt, 16, 16},
+				{i % 2 == 0 ? textures.stall_roof1 : textures.stall_roof1_alt, 0, 0}, {i % 2 == 0 ? textures.stall_roof2 : textures.stall_roof2_alt, 16, 0}
+			});
+		}
+
+		textures.tree_large = resources->compose_texture("tree_large", {{textures.tree_bottom, 0, 16}, {textures.tree_top, 0, 0}});
+		textures.tree_large_alt = resources->compose_texture("tree_large_alt", {{textures.tree_bottom_alt, 0, 16}, {textures.tree_top_alt, 0, 0}});
+		textures.tree_large_harvested = resources->compose_texture("tree_large_harvested", {{textures.tree_bottom_harvested, 0, 16}, {textures.tree_top_harvested, 0, 0}});
 	}
 
 	void app::load_ui()
@@ -353,6 +414,9 @@ namespace villa
 		// Cycle through events on queue
 		while(SDL_PollEvent(&event) != 0)
 		{
+			// Any event (mouse movement, clicks, window changes) may change what is displayed
+			display_dirty = true;
+
 			// Handle keyboard input
 			if(event.type == SDL_KEYDOWN)
 			{
@@ -399,6 +463,33 @@ namespace villa
 								timers.timescale = 2.0;
 							}
 						}
+						else if(event.key.keysym.sym == SDLK_f)
+						{
+							// Toggle fast-forward mode when F is pressed
+							timers.fast_forward = !timers.fast_forward;
+							std::cout << "Fast-forward " << (timers.fast_forward ? "enabled." : "disabled.") << std::endl;
+						}
+						else if(event.key.keysym.sym == SDLK_LEFT)
+						{
+							simulation_camera.pan(-32, 0);
+						}
+						else if(event.key.keysym.sym == SDLK_RIGHT)
+						{
+							simulation_camera.pan(32, 0);
+						}
+						else if(event.key.keysym.sym == SDLK_UP)
+						{
+							simulation_camera.pan(0, -32);
+						}
+						else if(event.key.keysym.sym == SDLK_DOWN)
+						{
+							simulation_camera.pan(0, 32);
+						}
+						else if(event.key.keysym.sym == SDLK_HOME)
+						{
+							// Show the whole map again when Home is pressed
+							simulation_camera.reset();
+						}
 						// No break as the simulation should inherit ESC and F11 key-presses
 					case appstate::menu_main :
 						if(event.key.keysym.sym == SDLK_ESCAPE)
@@ -434,6 +525,35 @@ namespace villa
 				// Simulate click on user interface
 				user_interface->click_at(x, y);
 			}
+			// Handle mouse wheel input
+			else if(event.type == SDL_MOUSEWHEEL)
+			{
+				if(state.top() == appstate::simulation || state.top() == appstate::simulation_end)
+				{
+					// Get coords of mouse
+					int x, y;
+					SDL_GetMouseState(&x, &y);
+
+					// Zoom in or out, keeping the point under the mouse in place
+					if(event.wheel.y > 0)
+					{
+						simulation_camera.zoom_at(1.25, x, y);
+					}
+					else if(event.wheel.y < 0)
+					{
+						simulation_camera.zoom_at(0.8, x, y);
+					}
+				}
+			}
+			// Handle mouse movement input
+			else if(event.type == SDL_MOUSEMOTION)
+			{
+				// Drag the map while the middle mouse button is held
+				if((state.top() == appstate::simulation || state.top() == appstate::simulation_end) && (event.motion.state & SDL_BUTTON_MMASK))
+				{
+					simulation_camera.pan(-event.motion.xrel, -event.motion.yrel);
+				}
+			}
 			// Handle mouse release input
 			else if(event.type == SDL_MOUSEBUTTONUP)
 			{
@@ -452,12 +572,29 @@ namespace villa
 							if(target == "Start Button")
 							{
 								state.push(appstate::simulation);
-								simulation_map.reset(new map(rng));
-								simulation_ai.reset(new ai_manager(simulation_map.get(), rng));
+
+								// Stop the previous simulation before creating the next, as only one thread may use the simulation objects at a time
+								simulation_state.reset();
+								simulation_state.reset(new simulation_runner(options.fixed_seed ? options.seed : time(nullptr), options.threads));
+								terrain_dirty = true;
+								hud.dirty = true;
+								simulation_camera.reset();
+
+								simulation* created = simulation_state->get_simulation();
+								std::cout << "Simulation seed: " << created->get_seed() << " (" << created->get_jobs()->get_thread_count() << " threads)" << std::endl;
+
+								arenastats allocation = created->get_map()->get_allocation_stats();
+								std::cout << "Simulation arena: " << allocation.live << " objects in " << allocation.chunks << " chunks (" << allocation.reserved / 1024 << " KB reserved)." << std::endl;
 
 								timers.simulation_start = SDL_GetTicks();
-								timers.simulation_time = timers.simulation_end = timers.villager_health = timers.villager_health_regen = timers.villager_needs = 0;
+								timers.simulation_end = 0;
+								timers.tick_report = SDL_GetTicks();
+								timers.tick_report_count = 0;
+								timers.tick_rate = 0;
 								timers.timescale = 1.0;
+								timers.fast_forward = false;
+
+								simulation_state->start();
 							}
 							else if(target == "Quit Button")
 							{
@@ -517,78 +654,27 @@ namespace villa
 							}
 							else
 							{
-								bool found = false;
+								// Print the details of the entity under the mouse once the simulation thread reaches the command
+								double world_x = simulation_camera.to_world_x(x), world_y = simulation_camera.to_world_y(y);
 
-								std::vector<villager*> villagers = simulation_map->get_villagers();
-
-								// Loop through each villager in the vector
-								for(std::vector<villager*>::const_iterator iterator = villagers.begin(); iterator != villagers.end(); ++iterator)
-								{
-									if((*iterator)->is_at(x, y))
-									{
-										switch((*iterator)->get_task()->get_type())
-										{
-											case tasktype::harvest :
-												std::cout << "Current Task: Harvest" << std::endl;break;
-											case tasktype::idle :
-												std::cout << "Current Task: Idle" << std::endl;break;
-											case tasktype::move :
-												std::cout << "Current Task: Move" << std::endl;break;
-											case tasktype::rest :
-												std::cout << "Current Task: Rest" << std::endl;break;
-											case tasktype::store_item :
-												std::cout << "Current Task: Store Item" << std::endl;break;
-											case tasktype::take_item :
-												std::cout << "Current Task: Take Item" << std::endl;break;
-											case tasktype::build :
-												std::cout << "Current Task: Build" << std::endl;break;
-										}
-										std::cout << "Villager X: " << (*iterator)->get_x() << " . Villager Y: " << (*iterator)->get_y() << " . Target X: " << (*iterator)->get_task()->get_data().target_coords.first << " . Target Y: " << (*iterator)->get_task()->get_data().target_coords.second << std::endl;
-										std::cout << "Task Count: " << (*iterator)->get_task_count() << " . Health: " << (*iterator)->get_health() << " . Fatigue: " << (*iterator)->get_fatigue() << " . Hunger: " << (*iterator)->get_hunger() << " . Thirst: " << (*iterator)->get_thirst() << " . Item Count: " << (*iterator)->get_inventory()->get_item_count() << "\n" << std::endl;
-										found = true;
-										break;
-									}
-								}
-
-								if(found == false)
+								simulation_state->run([world_x, world_y](simulation* target)
 								{
-									std::vector<building*> buildings = simulation_map->get_buildings();
-
-									// Loop through each building in the vector
-									for(std::vector<building*>::const_iterator iterator = buildings.begin(); iterator != buildings.end(); ++iterator)
-									{
-										if((*iterator)->is_at(x, y))
-										{
-											std::cout << "Building X: " << (*iterator)->get_x() << " . Building Y: " << (*iterator)->get_y() << " . Item Count: " << (*iterator)->get_inventory()->get_item_count() << "\n" << std::endl;
-											found = true;
-											break;
-										}
-									}
-								}
-
-								if(found == false)
-								{
-									std::vector<resource*> resources = simulation_map->get_resources();
-
-									// Loop through each building in the vector
-									for(std::vector<resource*>::const_iterator iterator = resources.begin(); iterator != resources.end(); ++iterator)
-									{
-										if((*iterator)->is_at(x, y))
-										{
-											std::cout << "Resource X: " << (*iterator)->get_x() << " . Resource Y: " << (*iterator)->get_y() << " . Item Count: " << (*iterator)->get_inventory()->get_item_count() << "\n" << std::endl;
-											break;
-										}
-									}
-								}
+									print_entity_at(target, world_x, world_y);
+								});
 							}
 						}
 						else if(event.button.button == SDL_BUTTON_RIGHT)
 						{
-							if(simulation_map->get_villagers().size() > 0)
+							std::pair<int, int> coords = std::make_pair(static_cast<int>(simulation_camera.to_world_x(x)), static_cast<int>(simulation_camera.to_world_y(y)));
+
+							simulation_state->run([coords](simulation* target)
 							{
-								simulation_map->get_villagers()[0]->add_task(new task(tasktype::rest, taskdata(std::make_pair(x, y), 500)));
-								//simulation_map->get_villagers()[0]->set_health(0);
-							}
+								if(target->get_map()->get_villagers().size() > 0)
+								{
+									target->get_map()->get_villagers()[0]->add_task(new task(tasktype::rest, taskdata(coords, 500)));
+									//target->get_map()->get_villagers()[0]->set_health(0);
+								}
+							});
 						}
 						break;
 
@@ -604,200 +690,230 @@ namespace villa
 			{
 				state.push(appstate::exit);
 			}
+			// If the contents of render targets were lost, bake the terrain again
+			else if(event.type == SDL_RENDER_TARGETS_RESET)
+			{
+				terrain_dirty = true;
+			}
 		}
 	}
 
 	/**
-	 * Updates the entities within the simulation.
-	 * Handles time-based state changes.
+	 * Passes the speed to the simulation thread and takes its newest snapshot.
+	 * The simulation is paused outside of the simulation state, and is set to the end state once no villagers remain.
 	 */
 	void app::update_simulation()
 	{
-		std::vector<villager*> villagers = simulation_map->get_villagers();
+		simulation_state->set_timescale(state.top() == appstate::simulation ? timers.timescale : 0);
+		simulation_state->set_fast_forward(timers.fast_forward && state.top() == appstate::simulation);
+
+		if(simulation_state->update_snapshot())
+		{
+			display_dirty = true;
+		}
 
-		// If no villagers remain, set the simulation to the end state
-		if(villagers.empty())
+		if(state.top() == appstate::simulation && simulation_state->get_snapshot()->finished)
 		{
-			timers.simulation_end = timers.simulation_time;
+			timers.simulation_end = simulation_state->get_snapshot()->time;
+			display_dirty = true;
 
 			state.pop();
 			state.push(appstate::simulation_end);
 		}
-		else
-		{
-			bool update_villager_health = false, update_villager_health_regen = false, update_villager_needs = false;
+	}
 
-			if(timers.simulation_time > timers.villager_health + 1000)
-			{
-				timers.villager_health = timers.simulation_time;
-				update_villager_health = true;
-			}
+	/**
+	 * Prints the details of the villager, building or resource at the coordinates to the console.
+	 * Runs on the simulation thread as a command, so only the simulation is used.
+	 * @param target - The simulation.
+	 * @param x - The x-coord (world) of the target.
+	 * @param y - The y-coord (world) of the target.
+	 */
+	void app::print_entity_at(simulation* target, double x, double y)
+	{
+		bool found = false;
 
-			if(timers.simulation_time > timers.villager_health_regen + 30000)
-			{
-				timers.villager_health_regen = timers.simulation_time;
-				update_villager_health_regen = true;
-			}
+		slot_view<villager> villagers = target->get_map()->get_villagers();
 
-			if(timers.simulation_time > timers.villager_needs + 15000)
+		// Loop through each villager in the vector
+		for(slot_view<villager>::iterator iterator = villagers.begin(); iterator != villagers.end(); ++iterator)
+		{
+			if((*iterator)->is_at(x, y))
 			{
-				timers.villager_needs = timers.simulation_time;
-				update_villager_needs = true;
+				switch((*iterator)->get_task()->get_type())
+				{
+					case tasktype::harvest :
+						std::cout << "Current Task: Harvest" << std::endl;break;
+					case tasktype::idle :
+						std::cout << "Current Task: Idle" << std::endl;break;
+					case tasktype::move :
+						std::cout << "Current Task: Move" << std::endl;break;
+					case tasktype::rest :
+						std::cout << "Current Task: Rest" << std::endl;break;
+					case tasktype::store_item :
+						std::cout << "Current Task: Store Item" << std::endl;break;
+					case tasktype::take_item :
+						std::cout << "Current Task: Take Item" << std::endl;break;
+					case tasktype::build :
+						std::cout << "Current Task: Build" << std::endl;break;
+				}
+				std::cout << "Villager X: " << (*iterator)->get_x() << " . Villager Y: " << (*iterator)->get_y() << " . Target X: " << (*iterator)->get_task()->get_data().target_coords.first << " . Target Y: " << (*iterator)->get_task()->get_data().target_coords.second << std::endl;
+				std::cout << "Task Count: " << (*iterator)->get_task_count() << " . Health: " << (*iterator)->get_health() << " . Fatigue: " << (*iterator)->get_fatigue() << " . Hunger: " << (*iterator)->get_hunger() << " . Thirst: " << (*iterator)->get_thirst() << " . Item Count: " << (*iterator)->get_inventory()->get_item_count() << "\n" << std::endl;
+				found = true;
+				break;
 			}
+		}
 
-			// Loop through each villager in the vector
-			for(std::vector<villager*>::iterator iterator = villagers.begin(); iterator != villagers.end(); ++iterator)
+		if(found == false)
+		{
+			slot_view<building> buildings = target->get_map()->get_buildings();
+
+			// Loop through each building in the vector
+			for(slot_view<building>::iterator iterator = buildings.begin(); iterator != buildings.end(); ++iterator)
 			{
-				// If the villager loses all health, create a grave resource containing all of its items
-				if((*iterator)->get_health() <= 0)
+				if((*iterator)->is_at(x, y))
 				{
-					resource* target = new resource((*iterator)->get_x(), (*iterator)->get_y(), resourcetype::grave);
-					inventory* villager_inv = (*iterator)->get_inventory();
-
-					while(villager_inv->get_item_count() > 0)
-					{
-						std::unique_ptr<item> target_item = villager_inv->take_item(villager_inv->get_items()[0]);
+					std::cout << "Building X: " << (*iterator)->get_x() << " . Building Y: " << (*iterator)->get_y() << " . Item Count: " << (*iterator)->get_inventory()->get_item_count() << "\n" << std::endl;
+					found = true;
+					break;
+				}
+			}
+		}
 
-						if(target_item.get() != nullptr)
-						{
-							target->get_inventory()->add_item(std::move(target_item));
-							target->set_harvestable(true);
-						}
-					}
+		if(found == false)
+		{
+			slot_view<resource> resources = target->get_map()->get_resources();
 
-					simulation_map->remove_villager(*iterator);
-					simulation_map->add_resource(target);
-				}
-				else
+			// Loop through each building in the vector
+			for(slot_view<resource>::iterator iterator = resources.begin(); iterator != resources.end(); ++iterator)
+			{
+				if((*iterator)->is_at(x, y))
 				{
-					if((*iterator)->get_health() > 100)
-					{
-						(*iterator)->set_health(100);
-					}
+					std::cout << "Resource X: " << (*iterator)->get_x() << " . Resource Y: " << (*iterator)->get_y() << " . Item Count: " << (*iterator)->get_inventory()->get_item_count() << "\n" << std::endl;
+					break;
+				}
+			}
+		}
+	}
 
-					if((*iterator)->get_fatigue() < 0)
-					{
-						(*iterator)->set_fatigue(0);
-					}
+	/**
+	 * Measures the number of simulation ticks run per wall-clock second.
+	 * The rate is updated every second, and reported to the console while fast-forwarding.
+	 */
+	void app::update_tick_rate()
+	{
+		if(state.top() == appstate::simulation && SDL_GetTicks() - timers.tick_report >= 1000)
+		{
+			unsigned long ticks = simulation_state->get_snapshot()->ticks;
 
-					if((*iterator)->get_hunger() < 0)
-					{
-						(*iterator)->set_hunger(0);
-					}
+			timers.tick_rate = (ticks - timers.tick_report_count) * 1000.0 / (SDL_GetTicks() - timers.tick_report);
+			timers.tick_report = SDL_GetTicks();
+			timers.tick_report_count = ticks;
 
-					if((*iterator)->get_thirst() < 0)
-					{
-						(*iterator)->set_thirst(0);
-					}
+			if(timers.fast_forward)
+			{
+				std::cout << "Fast-forward: " << (int)timers.tick_rate << " ticks/s (" << (int)(timers.tick_rate * simulation::UPDATE_TIME / 1000) << "x)" << std::endl;
+			}
+		}
+	}
 
-					// Reduce villager health by 1 every second if fatigue, hunger or thirst is above 100
-					if(update_villager_health == true)
-					{
-						if((*iterator)->get_fatigue() >= 100 || (*iterator)->get_hunger() >= 100 || (*iterator)->get_thirst() >= 100)
-						{
-							(*iterator)->set_health((*iterator)->get_health() - 1);
-						}
-					}
+	/**
+	 * Measures the frame rate and the CPU time used by the application.
+	 * Both are updated every second and shown in the window title.
+	 */
+	void app::update_usage()
+	{
+		unsigned int elapsed = SDL_GetTicks() - timers.usage_report;
 
-					// Increase villager health by 1 every 30 seconds
-					if(update_villager_health_regen == true)
-					{
-						(*iterator)->set_health((*iterator)->get_health() + 1);
-					}
+		if(elapsed >= 1000)
+		{
+			double cpu = get_cpu_time();
+			double cpu_usage = (cpu - timers.usage_cpu) * 1000 * 100 / elapsed;
+			std::stringstream ss;
 
-					// Increase villager fatigue, hunger and thirst by 1 every 15 seconds
-					if(update_villager_needs == true)
-					{
-						(*iterator)->set_fatigue((*iterator)->get_fatigue() + 1);
-						(*iterator)->set_hunger((*iterator)->get_hunger() + 1);
-						(*iterator)->set_thirst((*iterator)->get_thirst() + 1);
-					}
-				}
-			}
+			ss << "Villa (" << (int)(timers.frames * 1000.0 / elapsed) << " FPS, " << (int)cpu_usage << "% CPU)";
+			SDL_SetWindowTitle(window, ss.str().c_str());
 
-			std::vector<resource*> resources = simulation_map->get_resources();
+			timers.usage_report = SDL_GetTicks();
+			timers.usage_cpu = cpu;
+			timers.frames = 0;
+		}
+	}
 
-			// Loop through each resource in the vector
-			for(std::vector<resource*>::iterator iterator = resources.begin(); iterator != resources.end(); ++iterator)
-			{
-				// If the resource is on unpathable terrain, set it as unharvestable
-				if(simulation_map->get_tile_at((*iterator)->get_x() / 16, (*iterator)->get_y() / 16)->get_pathable() == false)
-				{
-					(*iterator)->set_harvestable(false);
-					(*iterator)->set_harvestable_time(0);
-				}
-				else
-				{
-					// Once the time has passed the resource timeout duration, set it as harvestable
-					// Also resets the inventory with a new set of items (excluding graves)
-					if((*iterator)->get_harvestable() == false && timers.simulation_time > (*iterator)->get_harvestable_time() && (*iterator)->get_harvestable_time() != 0)
-					{
-						(*iterator)->set_harvestable(true);
+	/**
+	 * Gets the CPU time used by the process (all threads, user and kernel).
+	 * std::clock is not used, as it measures wall-clock time on Windows.
+	 * @return The CPU time in seconds.
+	 */
+	double app::get_cpu_time()
+	{
+#ifdef _WIN32
+		FILETIME creation, exit, kernel, user;
 
-						// Scale down random number while preserving uniform distribution
-						std::uniform_int_distribution<int> distribution(1, 5);
-						int quantity = distribution(rng);
+		if(GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+		{
+			// File times are in units of 100 nanoseconds
+			ULARGE_INTEGER kernel_time, user_time;
+			kernel_time.LowPart = kernel.dwLowDateTime;
+			kernel_time.HighPart = kernel.dwHighDateTime;
+			user_time.LowPart = user.dwLowDateTime;
+			user_time.HighPart = user.dwHighDateTime;
+
+			return (kernel_time.QuadPart + user_time.QuadPart) / 10000000.0;
+		}
 
-						switch((*iterator)->get_type())
-						{
-							case resourcetype::water :
-								for(int i = 0; i < quantity; ++i)
-								{
-									(*iterator)->get_inventory()->add_item(new item(itemtype::water));
-								}
-								break;
+		return 0;
+#else
+		rusage usage;
 
-							case resourcetype::food :
-								for(int i = 0; i < quantity; ++i)
-								{
-									(*iterator)->get_inventory()->add_item(new item(itemtype::food));
-								}
-								break;
+		if(getrusage(RUSAGE_SELF, &usage) == 0)
+		{
+			return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000000.0;
+		}
 
-							case resourcetype::tree :
-								for(int i = 0; i < quantity; ++i)
-								{
-									(*iterator)->get_inventory()->add_item(new item(itemtype::lumber));
-								}
-								break;
+		return 0;
+#endif
+	}
 
-							case resourcetype::stone :
-								for(int i = 0; i < quantity; ++i)
-								{
-									(*iterator)->get_inventory()->add_item(new item(itemtype::stone));
-								}
-								break;
+	/**
+	 * Prints the time spent on each type of job by the simulation's job system.
+	 */
+	void app::print_job_stats()
+	{
+		job_system* jobs = simulation_state->get_simulation()->get_jobs();
 
-							case resourcetype::ore :
-								for(int i = 0; i < quantity; ++i)
-								{
-									(*iterator)->get_inventory()->add_item(new item(itemtype::stone));
-									(*iterator)->get_inventory()->add_item(new item(itemtype::ore));
-								}
-								break;
+		for(unsigned int i = 0; i < job_system::jobtype_count; ++i)
+		{
+			jobstats stats = jobs->get_stats(static_cast<jobtype>(i));
 
-							default :
-								break;
-						}
-					}
+			if(stats.jobs > 0)
+			{
+				std::cout << "Jobs (" << job_system::get_jobtype_name(static_cast<jobtype>(i)) << "): " << stats.jobs << " jobs, " << stats.seconds * 1000 << " ms" << std::endl;
+			}
+		}
+	}
 
-					// If all items have been harvested from the resource, set its harvestable state to false
-					if((*iterator)->get_inventory()->get_item_count() == 0 && (*iterator)->get_harvestable() == true)
-					{
-						(*iterator)->set_harvestable(false);
+	/**
+	 * Sleeps until the next frame is due.
+	 * Outside of the simulation there is no work between frames, so the application
+	 * waits for the next event instead, waking at least once per tick.
+	 * @param frame_start - The time at which the current frame started.
+	 */
+	void app::wait_for_frame(unsigned int frame_start)
+	{
+		unsigned int elapsed = SDL_GetTicks() - frame_start;
 
-						if((*iterator)->get_type() == resourcetype::grave)
-						{
-							(*iterator)->set_harvestable_time(0);
-						}
-						else
-						{
-							(*iterator)->set_harvestable_time(timers.simulation_time + 120000);
-						}
-					}
-				}
+		if(state.top() != appstate::simulation)
+		{
+			if(elapsed < (unsigned int)simulation::UPDATE_TIME)
+			{
+				SDL_WaitEventTimeout(nullptr, simulation::UPDATE_TIME - elapsed);
 			}
 		}
+		else if(options.frame_cap > 0 && elapsed < 1000 / options.frame_cap)
+		{
+			SDL_Delay(1000 / options.frame_cap - elapsed);
+		}
 	}
 
 	/**
@@ -806,6 +922,15 @@ namespace villa
 	 */
 	void app::update_display()
 	{
+		// Outside of the simulation the display is static, so only re-render it when something has changed
+		if(state.top() != appstate::simulation && !display_dirty)
+		{
+			return;
+		}
+
+		display_dirty = false;
+		timers.frames += 1;
+
 		SDL_RenderClear(renderer);
 
 		// Check the current application state
@@ -829,7 +954,7 @@ namespace villa
 		SDL_GetMouseState(&x, &y);
 
 		// Render the custom cursor at the mouse position
-		resources->render_texture(x - 4, y - 4, "cursor");
+		resources->render_texture(x - 4, y - 4, textures.cursor);
 
 		SDL_RenderPresent(renderer);
 	}
@@ -840,33 +965,33 @@ namespace villa
 	void app::display_menu_main()
 	{
 		// Render menu background
-		resources->render_texture(0, 0, "background");
+		resources->render_texture(0, 0, textures.background);
 
 		// Render title heading and sub-heading
-		resources->render_text(110, 0, "Villa", "KenPixel Blocks", 160, {64, 64, 64});
-		resources->render_text(168, 211, "A Humble Village AI Simulation", "KenPixel Square", 24, {64, 64, 64});
+		resources->render_text(110, 0, "Villa", fonts.blocks, {64, 64, 64});
+		resources->render_text(168, 211, "A Humble Village AI Simulation", fonts.square, {64, 64, 64});
 
 		// Render menu buttons and button text
 		if(user_interface->get_element_clicked() == "Start Button")
 		{
-			resources->render_texture(305, 629, "buttonLong_brown_pressed");
-			resources->render_text(357, 632, "Start", "KenPixel Square", 24, {224, 224, 224});
+			resources->render_texture(305, 629, textures.buttonLong_brown_pressed);
+			resources->render_text(357, 632, "Start", fonts.square, {224, 224, 224});
 		}
 		else
 		{
-			resources->render_texture(305, 625, "buttonLong_brown");
-			resources->render_text(357, 628, "Start", "KenPixel Square", 24, {224, 224, 224});
+			resources->render_texture(305, 625, textures.buttonLong_brown);
+			resources->render_text(357, 628, "Start", fonts.square, {224, 224, 224});
 		}
 
 		if(user_interface->get_element_clicked() == "Quit Button")
 		{
-			resources->render_texture(305, 704, "buttonLong_brown_pressed");
-			resources->render_text(369, 707, "Quit", "KenPixel Square", 24, {224, 224, 224});
+			resources->render_texture(305, 704, textures.buttonLong_brown_pressed);
+			resources->render_text(369, 707, "Quit", fonts.square, {224, 224, 224});
 		}
 		else
 		{
-			resources->render_texture(305, 700, "buttonLong_brown");
-			resources->render_text(369, 703, "Quit", "KenPixel Square", 24, {224, 224, 224});
+			resources->render_texture(305, 700, textures.buttonLong_brown);
+			resources->render_text(369, 703, "Quit", fonts.square, {224, 224, 224});
 		}
 	}
 
@@ -875,185 +1000,168 @@ namespace villa
 	 */
 	void app::display_simulation()
 	{
+		// Render the world through the camera
+		resources->set_view(simulation_camera.get_x(), simulation_camera.get_y(), simulation_camera.get_zoom());
+
 		// Render the map
-		for(int i = 0; i < 50; ++i)
-		{
-			for(int j = 0; j < 50; ++j)
-			{
-				tile* target = simulation_map->get_tile_at(i, j);
+		display_simulation_terrain();
 
-				if(target->get_type() == tiletype::water)
-				{
-					display_simulation_tile(i, j, tiletype::water, "water");
-				}
-				else
-				{
-					// Render a grass tile as the default underlying texture
-					// We do not need an if statement for grass tiles due to this
-					resources->render_texture(i * 16, j * 16, "grass_c");
+		simulation_snapshot* snapshot = simulation_state->get_snapshot();
 
-					if(target->get_type() == tiletype::dirt)
-					{
-						display_simulation_tile(i, j, tiletype::dirt, "dirt");
-					}
-					else if(target->get_type() == tiletype::sand)
-					{
-						display_simulation_tile(i, j, tiletype::sand, "sand");
-					}
-				}
-			}
-		}
-
-		// Render the resources
-		std::vector<resource*> map_resources = simulation_map->get_resources();
+		// Render the resources on the visible rows of tiles
+		// Resources are drawn up to 32 pixels above their position, so the rows just below the view are included
+		int first_row = std::max(static_cast<int>(simulation_camera.get_y()) / 16, 0), last_row = std::min(static_cast<int>(simulation_camera.to_world_y(800)) / 16 + 2, 49);
 
-		// Loop through each resource in the vector
-		for(std::vector<resource*>::const_iterator iterator = map_resources.begin(); iterator != map_resources.end(); ++iterator)
+		for(std::size_t i = snapshot->resource_rows[first_row]; i < snapshot->resource_rows[last_row + 1]; ++i)
 		{
-			int x = (*iterator)->get_x(), y = (*iterator)->get_y();
+			const resource_snapshot& value = snapshot->resources[i];
+			int x = value.x, y = value.y;
+
+			// Skip resources beside the view
+			if(!simulation_camera.is_visible(x - 8, y - 32, 16, 32))
+			{
+				continue;
+			}
 
 			// Display the appropriate resource according to type
-			switch((*iterator)->get_type())
+			switch(value.type)
 			{
 				case resourcetype::food :
-					if((*iterator)->get_harvestable() == true)
+					if(value.harvestable == true)
 					{
-						int texture_variant = std::hash<resource*>{}(*iterator) % 3;
+						int texture_variant = value.variant % 3;
 
 						if(texture_variant == 0)
 						{
-							resources->render_texture(x - 8, y - 16, "food_1");
+							resources->render_texture(x - 8, y - 16, textures.food_1);
 						}
 						else if(texture_variant == 1)
 						{
-							resources->render_texture(x - 8, y - 16, "food_2");
+							resources->render_texture(x - 8, y - 16, textures.food_2);
 						}
 						else if(texture_variant == 2)
 						{
-							resources->render_texture(x - 8, y - 16, "food_3");
+							resources->render_texture(x - 8, y - 16, textures.food_3);
 						}
 					}
 					else
 					{
-						resources->render_texture(x - 8, y - 16, "food_harvested");
+						resources->render_texture(x - 8, y - 16, textures.food_harvested);
 					}
 					break;
 
 				case resourcetype::tree :
 					{
-						int texture_variant = std::hash<resource*>{}(*iterator) % 3;
+						int texture_variant = value.variant % 3;
 
-						if((*iterator)->get_harvestable() == true)
+						if(value.harvestable == true)
 						{
 							if(texture_variant == 0)
 							{
-								resources->render_texture(x - 8, y - 16, "tree_small");
+								resources->render_texture(x - 8, y - 16, textures.tree_small);
 							}
 							else if(texture_variant == 1)
 							{
-								resources->render_texture(x - 8, y - 16, "tree_bottom");
-								resources->render_texture(x - 8, y - 32, "tree_top");
+								resources->render_texture(x - 8, y - 32, textures.tree_large);
 							}
 							else if(texture_variant == 2)
 							{
-								resources->render_texture(x - 8, y - 16, "tree_bottom_alt");
-								resources->render_texture(x - 8, y - 32, "tree_top_alt");
+								resources->render_texture(x - 8, y - 32, textures.tree_large_alt);
 							}
 						}
 						else
 						{
 							if(texture_variant == 0)
 							{
-								resources->render_texture(x - 8, y - 16, "tree_small_harvested");
+								resources->render_texture(x - 8, y - 16, textures.tree_small_harvested);
 							}
 							else if(texture_variant == 1 || texture_variant == 2)
 							{
-								resources->render_texture(x - 8, y - 16, "tree_bottom_harvested");
-								resources->render_texture(x - 8, y - 32, "tree_top_harvested");
+								resources->render_texture(x - 8, y - 32, textures.tree_large_harvested);
 							}
 						}
 					}
 					break;
 
 				case resourcetype::stone :
-					if((*iterator)->get_harvestable() == true)
+					if(value.harvestable == true)
 					{
-						int texture_variant = std::hash<resource*>{}(*iterator) % 6;
+						int texture_variant = value.variant % 6;
 
 						if(texture_variant == 0)
 						{
-							resources->render_texture(x - 8, y - 16, "stone_1");
+							resources->render_texture(x - 8, y - 16, textures.stone_1);
 						}
 						else if(texture_variant == 1)
 						{
-							resources->render_texture(x - 8, y - 16, "stone_2");
+							resources->render_texture(x - 8, y - 16, textures.stone_2);
 						}
 						else if(texture_variant == 2)
 						{
-							resources->render_texture(x - 8, y - 16, "stone_3");
+							resources->render_texture(x - 8, y - 16, textures.stone_3);
 						}
 						else if(texture_variant == 3)
 						{
-							resources->render_texture(x - 8, y - 16, "stone_4");
+							resources->render_texture(x - 8, y - 16, textures.stone_4);
 						}
 						else if(texture_variant == 4)
 						{
-							resources->render_texture(x - 8, y - 16, "stone_5");
+							resources->render_texture(x - 8, y - 16, textures.stone_5);
 						}
 						else if(texture_variant == 5)
 						{
-							resources->render_texture(x - 8, y - 16, "stone_6");
+							resources->render_texture(x - 8, y - 16, textures.stone_6);
 						}
 					}
 					break;
 
 				case resourcetype::ore :
-					if((*iterator)->get_harvestable() == true)
+					if(value.harvestable == true)
 					{
-						int texture_variant = std::hash<resource*>{}(*iterator) % 6;
+						int texture_variant = value.variant % 6;
 
 						if(texture_variant == 0)
 						{
-							resources->render_texture(x - 8, y - 16, "ore_1");
+							resources->render_texture(x - 8, y - 16, textures.ore_1);
 						}
 						else if(texture_variant == 1)
 						{
-							resources->render_texture(x - 8, y - 16, "ore_2");
+							resources->render_texture(x - 8, y - 16, textures.ore_2);
 						}
 						else if(texture_variant == 2)
 						{
-							resources->render_texture(x - 8, y - 16, "ore_3");
+							resources->render_texture(x - 8, y - 16, textures.ore_3);
 						}
 						else if(texture_variant == 3)
 						{
-							resources->render_texture(x - 8, y - 16, "ore_4");
+							resources->render_texture(x - 8, y - 16, textures.ore_4);
 						}
 						else if(texture_variant == 4)
 						{
-							resources->render_texture(x - 8, y - 16, "ore_5");
+							resources->render_texture(x - 8, y - 16, textures.ore_5);
 						}
 						else if(texture_variant == 5)
 						{
-							resources->render_texture(x - 8, y - 16, "ore_6");
+							resources->render_texture(x - 8, y - 16, textures.ore_6);
 						}
 					}
 					break;
 
 				case resourcetype::grave :
 					{
-						int texture_variant = std::hash<resource*>{}(*iterator) % 3;
+						int texture_variant = value.variant % 3;
 
 						if(texture_variant == 0)
 						{
-							resources->render_texture(x - 8, y - 16, "grave_1");
+							resources->render_texture(x - 8, y - 16, textures.grave_1);
 						}
 						else if(texture_variant == 1)
 						{
-							resources->render_texture(x - 8, y - 16, "grave_2");
+							resources->render_texture(x - 8, y - 16, textures.grave_2);
 						}
 						else if(texture_variant == 2)
 						{
-							resources->render_texture(x - 8, y - 16, "grave_3");
+							resources->render_texture(x - 8, y - 16, textures.grave_3);
 						}
 					}
 					break;
@@ -1064,99 +1172,41 @@ namespace villa
 		}
 
 		// Render the buildings
-		std::vector<building*> buildings = simulation_map->get_buildings();
-
-		// Loop through each building in the vector
-		for(std::vector<building*>::const_iterator iterator = buildings.begin(); iterator != buildings.end(); ++iterator)
+		for(std::vector<building_snapshot>::const_iterator iterator = snapshot->buildings.begin(); iterator != snapshot->buildings.end(); ++iterator)
 		{
-			int x = (*iterator)->get_x(), y = (*iterator)->get_y();
+			int x = iterator->x, y = iterator->y;
+
+			// Skip buildings outside of the view (the largest are 32 pixels wide and drawn from 64 pixels above their position)
+			if(!simulation_camera.is_visible(x, y - 64, 32, 64))
+			{
+				continue;
+			}
 
 			// Display the appropriate building according to type
-			switch((*iterator)->get_type())
+			switch(iterator->type)
 			{
 				case buildingtype::town_hall :
-					resources->render_texture(x, y - 16, "wall_large_base1");
-					resources->render_texture(x + 16, y - 16, "wall_large_base2");
-					resources->render_texture(x, y - 32, "wall_large_middle1");
-					resources->render_texture(x + 16, y - 32, "wall_large_middle2");
-					resources->render_texture(x, y - 64, "roof_large_back1");
-					resources->render_texture(x + 16, y - 64, "roof_large_back2");
-					resources->render_texture(x, y - 48, "roof_large_middle1");
-					resources->render_texture(x + 16, y - 48, "roof_large_middle2");
-					resources->render_texture(x, y - 32, "roof_large_front1");
-					resources->render_texture(x + 16, y - 32, "roof_large_front2");
-					resources->render_texture(x, y - 16, "door_large1");
-					resources->render_texture(x + 16, y - 16, "door_large2");
+					resources->render_texture(x, y - 64, textures.town_hall);
 					break;
 
 				case buildingtype::house :
-					resources->render_texture(x, y - 16, "wall_large_base1");
-					resources->render_texture(x + 16, y - 16, "wall_large_base2");
-					resources->render_texture(x, y - 32, "wall_large_middle1");
-					resources->render_texture(x + 16, y - 32, "wall_large_middle2");
-					resources->render_texture(x, y - 64, "roof_large_back1");
-					resources->render_texture(x + 16, y - 64, "roof_large_back2");
-					resources->render_texture(x, y - 48, "roof_large_middle1");
-					resources->render_texture(x + 16, y - 48, "roof_large_middle2");
-					resources->render_texture(x, y - 32, "roof_large_front1");
-					resources->render_texture(x + 16, y - 32, "roof_large_front2");
-					resources->render_texture(x + 8, y - 16, "door_small");
+					resources->render_texture(x, y - 64, textures.house);
 					break;
 
 				case buildingtype::house_small :
-					resources->render_texture(x, y - 16, "wall_small_base");
-					resources->render_texture(x, y - 32, "roof_small_back");
-					resources->render_texture(x, y - 24, "roof_small_front");
+					resources->render_texture(x, y - 32, textures.house_small);
 					break;
 
 				case buildingtype::farmhouse :
-					resources->render_texture(x, y - 16, "wall_large_base1");
-					resources->render_texture(x + 16, y - 16, "wall_large_base2");
-					resources->render_texture(x, y - 32, "wall_large_middle1");
-					resources->render_texture(x + 16, y - 32, "wall_large_middle2");
-					resources->render_texture(x, y - 64, "roof_large_back1_alt");
-					resources->render_texture(x + 16, y - 64, "roof_large_back2_alt");
-					resources->render_texture(x, y - 48, "roof_large_middle1");
-					resources->render_texture(x + 16, y - 48, "roof_large_middle2");
-					resources->render_texture(x, y - 32, "roof_large_front1_alt");
-					resources->render_texture(x + 16, y - 32, "roof_large_front2_alt");
-					resources->render_texture(x + 8, y - 16, "door_small_alt");
+					resources->render_texture(x, y - 64, textures.farmhouse);
 					break;
 
 				case buildingtype::blacksmith :
-					resources->render_texture(x, y - 16, "wall_large_base1");
-					resources->render_texture(x + 16, y - 16, "wall_large_base2");
-					resources->render_texture(x, y - 32, "roof_flat_back1");
-					resources->render_texture(x + 16, y - 32, "roof_flat_back2");
-					resources->render_texture(x + 8, y - 16, "blacksmith_forge");
+					resources->render_texture(x, y - 32, textures.blacksmith);
 					break;
 
 				case buildingtype::stall :
-					{
-						int texture_variant = std::hash<building*>{}(*iterator) % 4;
-
-						if(texture_variant <= 1)
-						{
-							resources->render_texture(x, y - 16, "stall_base1");
-							resources->render_texture(x + 16, y - 16, "stall_base2");
-						}
-						else if(texture_variant <= 3)
-						{
-							resources->render_texture(x, y - 16, "stall_base1_alt");
-							resources->render_texture(x + 16, y - 16, "stall_base2_alt");
-						}
-
-						if(texture_variant == 0 || texture_variant == 2)
-						{
-							resources->render_texture(x, y - 32, "stall_roof1");
-							resources->render_texture(x + 16, y - 32, "stall_roof2");
-						}
-						else if(texture_variant == 1 || texture_variant == 3)
-						{
-							resources->render_texture(x, y - 32, "stall_roof1_alt");
-							resources->render_texture(x + 16, y - 32, "stall_roof2_alt");
-						}
-					}
+					resources->render_texture(x, y - 32, textures.stall[iterator->variant % 4]);
 					break;
 
 				default :
@@ -1164,107 +1214,120 @@ namespace villa
 			}
 		}
 
-		// Render the villagers
-		std::vector<villager*> villagers = simulation_map->get_villagers();
+		// Render the villagers, moving them smoothly between their positions before and after the last tick
+		double alpha = snapshot->get_alpha(std::chrono::steady_clock::now());
 
 		// Loop through each villager in the vector
-		for(std::vector<villager*>::const_iterator iterator = villagers.begin(); iterator != villagers.end(); ++iterator)
+		for(std::vector<villager_snapshot>::const_iterator iterator = snapshot->villagers.begin(); iterator != snapshot->villagers.end(); ++iterator)
 		{
-			int x = (*iterator)->get_x(), y = (*iterator)->get_y();
-			int texture_variant = std::hash<villager*>{}(*iterator) % 40;
+			int x = static_cast<int>(std::floor(iterator->get_x(alpha))), y = static_cast<int>(std::floor(iterator->get_y(alpha)));
+			int texture_variant = iterator->variant % 40;
+
+			// Skip villagers outside of the view
+			if(!simulation_camera.is_visible(x - 12, y - 24, 24, 24))
+			{
+				continue;
+			}
 
 			if(texture_variant <= 10)
 			{
-				resources->render_texture(x - 12, y - 24, "villager");
+				resources->render_texture(x - 12, y - 24, textures.villager);
 			}
 			else if(texture_variant <= 20)
 			{
-				resources->render_texture(x - 12, y - 24, "villager_alt");
+				resources->render_texture(x - 12, y - 24, textures.villager_alt);
 			}
 			else if(texture_variant <= 30)
 			{
-				resources->render_texture(x - 12, y - 24, "villager_alt2");
+				resources->render_texture(x - 12, y - 24, textures.villager_alt2);
 			}
 			else if(texture_variant < 40)
 			{
-				resources->render_texture(x - 12, y - 24, "villager_alt3");
+				resources->render_texture(x - 12, y - 24, textures.villager_alt3);
 			}
 		}
 
-		// Render the UI
-		std::stringstream ss;
+		// Render the UI at screen positions
+		resources->reset_view();
+
 		unsigned int simulation_time = 0;
 
 		if(state.top() == appstate::simulation)
 		{
-			simulation_time = timers.simulation_time;
+			simulation_time = snapshot->time;
 		}
 		else if(state.top() == appstate::simulation_end)
 		{
 			simulation_time = timers.simulation_end - timers.simulation_start;
 		}
 
-		ss << std::setfill('0') << std::setw(2) << (int)(simulation_time / (1000 * 60 * 60)) % 60 << ":" << std::setfill('0') << std::setw(2) << (int)(simulation_time / (1000 * 60)) % 60 << ":" << std::setfill('0') << std::setw(2) << (int)(simulation_time / 1000) % 60;
+		update_hud(simulation_time);
 
-		resources->render_texture(305, -10, "buttonLong_brown_pressed");
-		resources->render_text(341, -4, ss.str(), "KenPixel Square", 24, {224, 224, 224});
+		resources->render_texture(305, -10, textures.buttonLong_brown_pressed);
+		resources->render_text(341, -4, hud.clock, fonts.square, {224, 224, 224});
 
-		resources->render_texture(4, 4, "buttonRound_brown");
-		resources->render_texture(14, 14, "iconCross_brown");
+		resources->render_texture(4, 4, textures.buttonRound_brown);
+		resources->render_texture(14, 14, textures.iconCross_brown);
 
-		resources->render_texture(4, 765, "menuBar_brown");
+		resources->render_texture(4, 765, textures.menuBar_brown);
 
-		resources->render_texture(8, 769, "villager");
-		resources->render_text(32, 769, ">" + std::to_string(simulation_map->get_villagers().size()), "KenPixel Square Medium", 20, {224, 224, 224});
+		resources->render_texture(8, 769, textures.villager);
+		resources->render_text(32, 769, hud.counters[0], fonts.square_medium, {224, 224, 224});
 
-		resources->render_texture(83, 782, "wall_small_base");
-		resources->render_texture(83, 766, "roof_small_back");
-		resources->render_texture(83, 774, "roof_small_front");
-		resources->render_text(107, 769, ">" + std::to_string(simulation_map->get_buildings().size()), "KenPixel Square Medium", 20, {224, 224, 224});
+		resources->render_texture(83, 782, textures.wall_small_base);
+		resources->render_texture(83, 766, textures.roof_small_back);
+		resources->render_texture(83, 774, textures.roof_small_front);
+		resources->render_text(107, 769, hud.counters[1], fonts.square_medium, {224, 224, 224});
 
-		resources->render_texture(158, 775, "food_1");
-		resources->render_text(182, 769, ">" + std::to_string(simulation_map->get_resource_count(resourcetype::food)), "KenPixel Square Medium", 20, {224, 224, 224});
+		resources->render_texture(158, 775, textures.food_1);
+		resources->render_text(182, 769, hud.counters[2], fonts.square_medium, {224, 224, 224});
 
-		resources->render_texture(233, 777, "tree_small");
-		resources->render_text(258, 769, ">" + std::to_string(simulation_map->get_resource_count(resourcetype::tree)), "KenPixel Square Medium", 20, {224, 224, 224});
+		resources->render_texture(233, 777, textures.tree_small);
+		resources->render_text(258, 769, hud.counters[3], fonts.square_medium, {224, 224, 224});
 
-		resources->render_texture(308, 774, "stone_1");
-		resources->render_text(332, 769, ">" + std::to_string(simulation_map->get_resource_count(resourcetype::stone)), "KenPixel Square Medium", 20, {224, 224, 224});
+		resources->render_texture(308, 774, textures.stone_1);
+		resources->render_text(332, 769, hud.counters[4], fonts.square_medium, {224, 224, 224});
 
-		resources->render_texture(383, 774, "ore_1");
-		resources->render_text(407, 769, ">" + std::to_string(simulation_map->get_resource_count(resourcetype::ore)), "KenPixel Square Medium", 20, {224, 224, 224});
+		resources->render_texture(383, 774, textures.ore_1);
+		resources->render_text(407, 769, hud.counters[5], fonts.square_medium, {224, 224, 224});
 
-		resources->render_texture(458, 774, "grave_1");
-		resources->render_text(482, 769, ">" + std::to_string(simulation_map->get_resource_count(resourcetype::grave)), "KenPixel Square Medium", 20, {224, 224, 224});
+		resources->render_texture(458, 774, textures.grave_1);
+		resources->render_text(482, 769, hud.counters[6], fonts.square_medium, {224, 224, 224});
 
-		if(timers.timescale == 0.25)
+		// In fast-forward mode, show the achieved tick rate instead of the timescale
+		if(timers.fast_forward)
 		{
-			resources->render_text(698, 769, "0.25", "KenPixel Square Medium", 20, {224, 224, 224});
-			resources->render_text(748, 776, "x", "KenPixel Square Small", 14, {224, 224, 224});
+			resources->render_text(705, 769, "MAX", fonts.square_medium, {224, 224, 224});
+			resources->render_text(690, 744, hud.tick_rate_text, fonts.square_small, {224, 224, 224});
+		}
+		else if(timers.timescale == 0.25)
+		{
+			resources->render_text(698, 769, "0.25", fonts.square_medium, {224, 224, 224});
+			resources->render_text(748, 776, "x", fonts.square_small, {224, 224, 224});
 		}
 		else if(timers.timescale == 0.5)
 		{
-			resources->render_text(706, 769, "0.5", "KenPixel Square Medium", 20, {224, 224, 224});
-			resources->render_text(741, 776, "x", "KenPixel Square Small", 14, {224, 224, 224});
+			resources->render_text(706, 769, "0.5", fonts.square_medium, {224, 224, 224});
+			resources->render_text(741, 776, "x", fonts.square_small, {224, 224, 224});
 		}
 		else if(timers.timescale == 1.0)
 		{
-			resources->render_text(708, 769, "1.0", "KenPixel Square Medium", 20, {224, 224, 224});
-			resources->render_text(739, 776, "x", "KenPixel Square Small", 14, {224, 224, 224});
+			resources->render_text(708, 769, "1.0", fonts.square_medium, {224, 224, 224});
+			resources->render_text(739, 776, "x", fonts.square_small, {224, 224, 224});
 		}
 		else if(timers.timescale == 2.0)
 		{
-			resources->render_text(706, 769, "2.0", "KenPixel Square Medium", 20, {224, 224, 224});
-			resources->render_text(741, 776, "x", "KenPixel Square Small", 14, {224, 224, 224});
+			resources->render_text(706, 769, "2.0", fonts.square_medium, {224, 224, 224});
+			resources->render_text(741, 776, "x", fonts.square_small, {224, 224, 224});
 		}
 		else if(timers.timescale == 4.0)
 		{
-			resources->render_text(706, 769, "4.0", "KenPixel Square Medium", 20, {224, 224, 224});
-			resources->render_text(741, 776, "x", "KenPixel Square Small", 14, {224, 224, 224});
+			resources->render_text(706, 769, "4.0", fonts.square_medium, {224, 224, 224});
+			resources->render_text(741, 776, "x", fonts.square_small, {224, 224, 224});
 		}
 
-		resources->render_texture(668, 774, "arrowBeige_left");
-		resources->render_texture(765, 774, "arrowBeige_right");
+		resources->render_texture(668, 774, textures.arrowBeige_left);
+		resources->render_texture(765, 774, textures.arrowBeige_right);
 
 		// Get coords of mouse
 		int x, y;
@@ -1273,61 +1336,62 @@ namespace villa
 		// Villager Icon on Menu Bar
 		if(x >= 8 && x < 83 && y >= 769 && y <= 800)
 		{
-			resources->render_texture(x, y - 37, "label_villager");
-			resources->render_text(x + 11, y - 35, "Villager", "KenPixel Square Medium", 20, {224, 224, 224});
+			resources->render_texture(x, y - 37, textures.label_villager);
+			resources->render_text(x + 11, y - 35, "Villager", fonts.square_medium, {224, 224, 224});
 		}
 		// Building Icon on Menu Bar
 		else if(x >= 83 && x < 158 && y >= 769 && y <= 800)
 		{
-			resources->render_texture(x, y - 37, "label_building");
-			resources->render_text(x + 10, y - 35, "Building", "KenPixel Square Medium", 20, {224, 224, 224});
+			resources->render_texture(x, y - 37, textures.label_building);
+			resources->render_text(x + 10, y - 35, "Building", fonts.square_medium, {224, 224, 224});
 		}
 		// Food Icon on Menu Bar
 		else if(x >= 158 && x < 233 && y >= 769 && y <= 800)
 		{
-			resources->render_texture(x, y - 37, "label_food");
-			resources->render_text(x + 10, y - 35, "Food", "KenPixel Square Medium", 20, {224, 224, 224});
+			resources->render_texture(x, y - 37, textures.label_food);
+			resources->render_text(x + 10, y - 35, "Food", fonts.square_medium, {224, 224, 224});
 		}
 		// Tree Icon on Menu Bar
 		else if(x >= 233 && x < 308 && y >= 769 && y <= 800)
 		{
-			resources->render_texture(x, y - 37, "label_tree");
-			resources->render_text(x + 9, y - 35, "Tree", "KenPixel Square Medium", 20, {224, 224, 224});
+			resources->render_texture(x, y - 37, textures.label_tree);
+			resources->render_text(x + 9, y - 35, "Tree", fonts.square_medium, {224, 224, 224});
 		}
 		// Stone Icon on Menu Bar
 		else if(x >= 308 && x < 383 && y >= 769 && y <= 800)
 		{
-			resources->render_texture(x, y - 37, "label_stone");
-			resources->render_text(x + 10, y - 35, "Stone", "KenPixel Square Medium", 20, {224, 224, 224});
+			resources->render_texture(x, y - 37, textures.label_stone);
+			resources->render_text(x + 10, y - 35, "Stone", fonts.square_medium, {224, 224, 224});
 		}
 		// Ore Icon on Menu Bar
 		else if(x >= 383 && x < 458 && y >= 769 && y <= 800)
 		{
-			resources->render_texture(x, y - 37, "label_ore");
-			resources->render_text(x + 9, y - 35, "Ore", "KenPixel Square Medium", 20, {224, 224, 224});
+			resources->render_texture(x, y - 37, textures.label_ore);
+			resources->render_text(x + 9, y - 35, "Ore", fonts.square_medium, {224, 224, 224});
 		}
 		// Grave Icon on Menu Bar
 		else if(x >= 458 && x < 533 && y >= 769 && y <= 800)
 		{
-			resources->render_texture(x, y - 37, "label_grave");
-			resources->render_text(x + 10, y - 35, "Grave", "KenPixel Square Medium", 20, {224, 224, 224});
+			resources->render_texture(x, y - 37, textures.label_grave);
+			resources->render_text(x + 10, y - 35, "Grave", fonts.square_medium, {224, 224, 224});
 		}
 		else
 		{
 			bool found = false;
+			double world_x = simulation_camera.to_world_x(x), world_y = simulation_camera.to_world_y(y);
 
 			// Loop through each villager in the vector
-			for(std::vector<villager*>::const_iterator iterator = villagers.begin(); iterator != villagers.end() && found == false; ++iterator)
+			for(std::vector<villager_snapshot>::const_iterator iterator = snapshot->villagers.begin(); iterator != snapshot->villagers.end() && found == false; ++iterator)
 			{
-				if((*iterator)->is_at(x, y))
+				if(iterator->is_at(world_x, world_y))
 				{
 					if(x > 668)
 					{
 						x -= 131;
 					}
 
-					resources->render_texture(x, y - 37, "label_villager");
-					resources->render_text(x + 11, y - 35, "Villager", "KenPixel Square Medium", 20, {224, 224, 224});
+					resources->render_texture(x, y - 37, textures.label_villager);
+					resources->render_text(x + 11, y - 35, "Villager", fonts.square_medium, {224, 224, 224});
 
 					found = true;
 					break;
@@ -1335,17 +1399,17 @@ namespace villa
 			}
 
 			// Loop through each building in the vector
-			for(std::vector<building*>::const_iterator iterator = buildings.begin(); iterator != buildings.end() && found == false; ++iterator)
+			for(std::vector<building_snapshot>::const_iterator iterator = snapshot->buildings.begin(); iterator != snapshot->buildings.end() && found == false; ++iterator)
 			{
-				if((*iterator)->is_at(x, y))
+				if(iterator->is_at(world_x, world_y))
 				{
 					if(x > 671)
 					{
 						x -= 128;
 					}
 
-					resources->render_texture(x, y - 37, "label_building");
-					resources->render_text(x + 10, y - 35, "Building", "KenPixel Square Medium", 20, {224, 224, 224});
+					resources->render_texture(x, y - 37, textures.label_building);
+					resources->render_text(x + 10, y - 35, "Building", fonts.square_medium, {224, 224, 224});
 
 					found = true;
 					break;
@@ -1353,11 +1417,11 @@ namespace villa
 			}
 
 			// Loop through each building in the vector
-			for(std::vector<resource*>::const_iterator iterator = map_resources.begin(); iterator != map_resources.end() && found == false; ++iterator)
+			for(std::vector<resource_snapshot>::const_iterator iterator = snapshot->resources.begin(); iterator != snapshot->resources.end() && found == false; ++iterator)
 			{
-				if((*iterator)->is_at(x, y))
+				if(iterator->is_at(world_x, world_y))
 				{
-					switch((*iterator)->get_type())
+					switch(iterator->type)
 					{
 						case resourcetype::food :
 							if(x > 721)
@@ -1365,8 +1429,8 @@ namespace villa
 								x -= 78;
 							}
 
-							resources->render_texture(x, y - 37, "label_food");
-							resources->render_text(x + 10, y - 35, "Food", "KenPixel Square Medium", 20, {224, 224, 224});
+							resources->render_texture(x, y - 37, textures.label_food);
+							resources->render_text(x + 10, y - 35, "Food", fonts.square_medium, {224, 224, 224});
 							break;
 
 						case resourcetype::grave :
@@ -1375,8 +1439,8 @@ namespace villa
 								x -= 94;
 							}
 
-							resources->render_texture(x, y - 37, "label_grave");
-							resources->render_text(x + 10, y - 35, "Grave", "KenPixel Square Medium", 20, {224, 224, 224});
+							resources->render_texture(x, y - 37, textures.label_grave);
+							resources->render_text(x + 10, y - 35, "Grave", fonts.square_medium, {224, 224, 224});
 							break;
 
 						case resourcetype::ore :
@@ -1385,8 +1449,8 @@ namespace villa
 								x -= 63;
 							}
 
-							resources->render_texture(x, y - 37, "label_ore");
-							resources->render_text(x + 9, y - 35, "Ore", "KenPixel Square Medium", 20, {224, 224, 224});
+							resources->render_texture(x, y - 37, textures.label_ore);
+							resources->render_text(x + 9, y - 35, "Ore", fonts.square_medium, {224, 224, 224});
 							break;
 
 						case resourcetype::stone :
@@ -1395,8 +1459,8 @@ namespace villa
 								x -= 94;
 							}
 
-							resources->render_texture(x, y - 37, "label_stone");
-							resources->render_text(x + 10, y - 35, "Stone", "KenPixel Square Medium", 20, {224, 224, 224});
+							resources->render_texture(x, y - 37, textures.label_stone);
+							resources->render_text(x + 10, y - 35, "Stone", fonts.square_medium, {224, 224, 224});
 							break;
 
 						case resourcetype::tree :
@@ -1405,8 +1469,8 @@ namespace villa
 								x -= 78;
 							}
 
-							resources->render_texture(x, y - 37, "label_tree");
-							resources->render_text(x + 9, y - 35, "Tree", "KenPixel Square Medium", 20, {224, 224, 224});
+							resources->render_texture(x, y - 37, textures.label_tree);
+							resources->render_text(x + 9, y - 35, "Tree", fonts.square_medium, {224, 224, 224});
 							break;
 
 						default :
@@ -1419,110 +1483,228 @@ namespace villa
 	}
 
 	/**
-	 * Displays the specified tile in the simulation.
-	 * Textures must be named using the following formats :
-	 * 1. (filename)_(direction).png
-	 * 2. (filename)_corner_(direction).png
-	 *
-	 * Directions are declared as the first letters of north, south, east or west.
-	 * Two combinations of letters can be used to specify diagonal directions.
-	 * Example : texture_nw.png, texture_corner_nw.png
-	 *
-	 * @param x - The x-coord (grid) of the target tile.
-	 * @param y - The y-coord (grid) of the target tile.
-	 * @param type - The tile type to search for.
-	 * @param name - The name of the texture (without direction).
+	 * Formats the changing text of the simulation HUD.
+	 * The clock and tick rate are formatted when their values change, and the counters are refreshed a few times per second,
+	 * so that the text is not formatted (and the resources are not counted) every frame.
+	 * @param simulation_time - The simulation time to show on the clock.
 	 */
-	void app::display_simulation_tile(int x, int y, tiletype type, std::string name)
+	void app::update_hud(unsigned int simulation_time)
 	{
-		// We store the directions which have the specified tile type.
-		// Allows for custom textures to be used for tile edges.
-		int direction = 0;
+		const unsigned int HUD_REFRESH_TIME = 250;
 
-		// Check the tile north of current tile
-		if((y - 1) >= 0 && simulation_map->get_tile_at(x, y - 1)->get_type() != type)
+		if(hud.dirty || hud.seconds != simulation_time / 1000)
 		{
-			direction += 1;
+			std::stringstream ss;
+			hud.seconds = simulation_time / 1000;
+
+			ss << std::setfill('0') << std::setw(2) << (int)(simulation_time / (1000 * 60 * 60)) % 60 << ":" << std::setfill('0') << std::setw(2) << (int)(simulation_time / (1000 * 60)) % 60 << ":" << std::setfill('0') << std::setw(2) << (int)(simulation_time / 1000) % 60;
+			hud.clock = ss.str();
 		}
 
-		// Check the tile west of current tile
-		if((x - 1) >= 0 && simulation_map->get_tile_at(x - 1, y)->get_type() != type)
+		if(hud.dirty || hud.tick_rate != (int)timers.tick_rate)
 		{
-			direction += 2;
+			hud.tick_rate = (int)timers.tick_rate;
+			hud.tick_rate_text = std::to_string(hud.tick_rate) + " t/s";
 		}
 
-		// Check the tile east of current tile
-		if((x + 1) < 50 && simulation_map->get_tile_at(x + 1, y)->get_type() != type)
+		if(hud.dirty || SDL_GetTicks() - hud.refresh >= HUD_REFRESH_TIME)
 		{
-			direction += 4;
+			simulation_snapshot* snapshot = simulation_state->get_snapshot();
+			hud.refresh = SDL_GetTicks();
+
+			hud.counters[0] = ">" + std::to_string(snapshot->villagers.size());
+			hud.counters[1] = ">" + std::to_string(snapshot->buildings.size());
+			hud.counters[2] = ">" + std::to_string(snapshot->resource_counts[static_cast<int>(resourcetype::food)]);
+			hud.counters[3] = ">" + std::to_string(snapshot->resource_counts[static_cast<int>(resourcetype::tree)]);
+			hud.counters[4] = ">" + std::to_string(snapshot->resource_counts[static_cast<int>(resourcetype::stone)]);
+			hud.counters[5] = ">" + std::to_string(snapshot->resource_counts[static_cast<int>(resourcetype::ore)]);
+			hud.counters[6] = ">" + std::to_string(snapshot->resource_counts[static_cast<int>(resourcetype::grave)]);
 		}
 
-		// Check the tile south of current tile
-		if((y + 1) < 50 && simulation_map->get_tile_at(x, y + 1)->get_type() != type)
+		hud.dirty = false;
+	}
+
+	/**
+	 * Displays the terrain of the simulation.
+	 * The terrain is baked into render target textures, which are only redrawn when the terrain changes.
+	 * If render targets are not supported, each tile is rendered directly instead.
+	 */
+	void app::display_simulation_terrain()
+	{
+		// Bake the terrain again for a new simulation, or once the snapshot reports that its tiles have changed
+		if(terrain_dirty || terrain_version != simulation_state->get_snapshot()->terrain_version)
 		{
-			direction += 8;
+			if(bake_simulation_terrain())
+			{
+				terrain_dirty = false;
+				terrain_version = simulation_state->get_snapshot()->terrain_version;
+			}
+			else
+			{
+				destroy_simulation_terrain();
+			}
+
+			resources->set_view(simulation_camera.get_x(), simulation_camera.get_y(), simulation_camera.get_zoom());
 		}
 
-		switch(direction)
+		// Render each visible chunk of baked terrain in a single call
+		if(terrain_chunks[0][0] != nullptr)
 		{
-			case 1 : // 1 tile (north)
-				resources->render_texture(x * 16, y * 16, name + "_n");
-				break;
-
-			case 2 : // 1 tile (west)
-				resources->render_texture(x * 16, y * 16, name + "_w");
-				break;
+			for(int i = 0; i < TERRAIN_CHUNKS; ++i)
+			{
+				for(int j = 0; j < TERRAIN_CHUNKS; ++j)
+				{
+					int width, height;
+					SDL_QueryTexture(terrain_chunks[i][j], nullptr, nullptr, &width, &height);
 
-			case 3 : // 2 tiles (north, west)
-				resources->render_texture(x * 16, y * 16, name + "_nw");
-				break;
+					if(simulation_camera.is_visible(i * TERRAIN_CHUNK_TILES * 16, j * TERRAIN_CHUNK_TILES * 16, width, height))
+					{
+						SDL_Rect chunk_rect = resources->get_view_rect(i * TERRAIN_CHUNK_TILES * 16, j * TERRAIN_CHUNK_TILES * 16, width, height);
 
-			case 4 : // 1 tile (east)
-				resources->render_texture(x * 16, y * 16, name + "_e");
-				break;
+						SDL_RenderCopy(renderer, terrain_chunks[i][j], nullptr, &chunk_rect);
+					}
+				}
+			}
+		}
+		else
+		{
+			// Render only the visible tiles
+			int first_x = static_cast<int>(simulation_camera.get_x()) / 16, first_y = static_cast<int>(simulation_camera.get_y()) / 16;
+			int last_x = std::min(static_cast<int>(simulation_camera.to_world_x(800)) / 16, 49), last_y = std::min(static_cast<int>(simulation_camera.to_world_y(800)) / 16, 49);
 
-			case 5 : // 2 tiles (north, east)
-				resources->render_texture(x * 16, y * 16, name + "_ne");
-				break;
+			for(int i = first_x; i <= last_x; ++i)
+			{
+				for(int j = first_y; j <= last_y; ++j)
+				{
+					display_simulation_terrain_tile(i, j, 0, 0);
+				}
+			}
+		}
+	}
 
-			case 8 : // 1 tile (south)
-				resources->render_texture(x * 16, y * 16, name + "_s");
-				break;
+	/**
+	 * Renders the terrain of the simulation into the render target texture of each chunk.
+	 * The textures are created the first time the terrain is baked.
+	 * @return Boolean representing whether the terrain was baked (false if render targets are not supported).
+	 */
+	bool app::bake_simulation_terrain()
+	{
+		if(!SDL_RenderTargetSupported(renderer))
+		{
+			return false;
+		}
 
-			case 10 : // 2 tiles (south, west)
-				resources->render_texture(x * 16, y * 16, name + "_sw");
-				break;
+		// Tiles are rendered at their position within the chunk, so the camera does not apply
+		resources->reset_view();
 
-			case 12 : // 2 tiles (south, east)
-				resources->render_texture(x * 16, y * 16, name + "_se");
-				break;
+		for(int i = 0; i < TERRAIN_CHUNKS; ++i)
+		{
+			for(int j = 0; j < TERRAIN_CHUNKS; ++j)
+			{
+				// The last chunk in each row and column only covers the remaining tiles
+				int first_x = i * TERRAIN_CHUNK_TILES, first_y = j * TERRAIN_CHUNK_TILES;
+				int last_x = std::min(first_x + TERRAIN_CHUNK_TILES, 50), last_y = std::min(first_y + TERRAIN_CHUNK_TILES, 50);
 
-			default :
-				// Check the tile in the northwest corner
-				if((x - 1) >= 0 && (y - 1) >= 0 && simulation_map->get_tile_at(x - 1, y - 1)->get_type() != type)
+				if(terrain_chunks[i][j] == nullptr)
 				{
-					resources->render_texture(x * 16, y * 16, name + "_corner_se");
-				}
-				// Check the tile in the northeast corner
-				else if((x - 1) >= 0 && (y + 1) < 50 && simulation_map->get_tile_at(x - 1, y + 1)->get_type() != type)
-				{
-					resources->render_texture(x * 16, y * 16, name + "_corner_ne");
+					terrain_chunks[i][j] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, (last_x - first_x) * 16, (last_y - first_y) * 16);
+
+					if(terrain_chunks[i][j] == nullptr)
+					{
+						std::cerr << "Failed to create terrain texture! SDL_Error: " << SDL_GetError() << std::endl;
+						return false;
+					}
+
+					// The terrain is opaque, so it replaces whatever is beneath it
+					SDL_SetTextureBlendMode(terrain_chunks[i][j], SDL_BLENDMODE_NONE);
 				}
-				// Check the tile in the southwest corner
-				else if((x + 1) < 50 && (y - 1) >= 0 && simulation_map->get_tile_at(x + 1, y - 1)->get_type() != type)
+
+				if(SDL_SetRenderTarget(renderer, terrain_chunks[i][j]) != 0)
 				{
-					resources->render_texture(x * 16, y * 16, name + "_corner_nw");
+					std::cerr << "Failed to render to terrain texture! SDL_Error: " << SDL_GetError() << std::endl;
+					SDL_SetRenderTarget(renderer, nullptr);
+					return false;
 				}
-				// Check the tile in the southeast corner
-				else if((x + 1) < 50 && (y + 1) < 50 && simulation_map->get_tile_at(x + 1, y + 1)->get_type() != type)
+
+				SDL_RenderClear(renderer);
+
+				for(int x = first_x; x < last_x; ++x)
 				{
-					resources->render_texture(x * 16, y * 16, name + "_corner_sw");
+					for(int y = first_y; y < last_y; ++y)
+					{
+						display_simulation_terrain_tile(x, y, first_x, first_y);
+					}
 				}
-				else
+			}
+		}
+
+		SDL_SetRenderTarget(renderer, nullptr);
+
+		return true;
+	}
+
+	/**
+	 * Displays the terrain of the specified tile in the simulation.
+	 * @param x - The x-coord (grid) of the target tile.
+	 * @param y - The y-coord (grid) of the target tile.
+	 * @param origin_x - The x-coord (grid) of the tile at the left edge of the render target.
+	 * @param origin_y - The y-coord (grid) of the tile at the top edge of the render target.
+	 */
+	void app::display_simulation_terrain_tile(int x, int y, int origin_x, int origin_y)
+	{
+		tiletype type = simulation_state->get_snapshot()->tiles[x][y].type;
+
+		if(type == tiletype::water)
+		{
+			display_simulation_tile(x, y, origin_x, origin_y, textures.water);
+		}
+		else
+		{
+			// Render a grass tile as the default underlying texture
+			// We do not need an if statement for grass tiles due to this
+			resources->render_texture((x - origin_x) * 16, (y - origin_y) * 16, textures.grass_c);
+
+			if(type == tiletype::dirt)
+			{
+				display_simulation_tile(x, y, origin_x, origin_y, textures.dirt);
+			}
+			else if(type == tiletype::sand)
+			{
+				display_simulation_tile(x, y, origin_x, origin_y, textures.sand);
+			}
+		}
+	}
+
+	/**
+	 * Destroys the render target textures of the baked terrain.
+	 */
+	void app::destroy_simulation_terrain()
+	{
+		for(int i = 0; i < TERRAIN_CHUNKS; ++i)
+		{
+			for(int j = 0; j < TERRAIN_CHUNKS; ++j)
+			{
+				if(terrain_chunks[i][j] != nullptr)
 				{
-					resources->render_texture(x * 16, y * 16, name + "_c");
+					SDL_DestroyTexture(terrain_chunks[i][j]);
+					terrain_chunks[i][j] = nullptr;
 				}
-				break;
+			}
 		}
 	}
+
+	/**
+	 * Displays the specified tile in the simulation, with the texture of its variant.
+	 * @param x - The x-coord (grid) of the target tile.
+	 * @param y - The y-coord (grid) of the target tile.
+	 * @param origin_x - The x-coord (grid) of the tile at the left edge of the render target.
+	 * @param origin_y - The y-coord (grid) of the tile at the top edge of the render target.
+	 * @param tileset - The textures of the tile type for each variant.
+	 */
+	void app::display_simulation_tile(int x, int y, int origin_x, int origin_y, const tileset_struct& tileset)
+	{
+		tilevariant variant = simulation_state->get_snapshot()->tiles[x][y].variant;
+
+		resources->render_texture((x - origin_x) * 16, (y - origin_y) * 16, tileset.variants[static_cast<int>(variant)]);
+	}
 }
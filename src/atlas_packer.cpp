@@ -0,0 +1,92 @@
+#include "atlas_packer.hpp"
+
+namespace villa
+{
+	/**
+	 * Constructor for the Atlas Packer class.
+	 * @param width - The width of the page.
+	 * @param height - The height of the page.
+	 * @param padding - The empty space to leave to the right of and below each rectangle.
+	 */
+	atlas_packer::atlas_packer(int width, int height, int padding) : width(width), height(height), padding(padding) { }
+
+	/**
+	 * Finds space on the page for a rectangle.
+	 * The rectangle is placed on the first shelf with room for it, or on a new shelf below the others.
+	 * @param width - The width of the rectangle.
+	 * @param height - The height of the rectangle.
+	 * @param x - The x-coord of the rectangle on the page.
+	 * @param y - The y-coord of the rectangle on the page.
+	 * @return Boolean representing whether the rectangle fits on the page.
+	 */
+	bool atlas_packer::insert(int width, int height, int& x, int& y)
+	{
+		if(width <= 0 || height <= 0 || width > this->width || height > this->height)
+		{
+			return false;
+		}
+
+		int padded_width = width + this->padding, padded_height = height + this->padding;
+
+		for(std::vector<shelf>::iterator iterator = this->shelves.begin(); iterator != this->shelves.end(); ++iterator)
+		{
+			// The rectangle may be taller than the shelf only if the shelf is the last one and there is space below it
+			bool last = iterator + 1 == this->shelves.end();
+			bool fits_height = padded_height <= iterator->height || (last && iterator->y + height <= this->height);
+
+			if(fits_height && iterator->used + width <= this->width)
+			{
+				x = iterator->used;
+				y = iterator->y;
+				iterator->used += padded_width;
+
+				if(padded_height > iterator->height)
+				{
+					iterator->height = padded_height;
+				}
+
+				return true;
+			}
+		}
+
+		int top = get_used_height();
+
+		if(top + height > this->height)
+		{
+			return false;
+		}
+
+		this->shelves.push_back(shelf{top, padded_height, padded_width});
+		x = 0;
+		y = top;
+
+		return true;
+	}
+
+	/**
+	 * Gets the width of the page.
+	 * @return The width of the page.
+	 */
+	int atlas_packer::get_width()
+	{
+		return this->width;
+	}
+
+	/**
+	 * Gets the height of the page.
+	 * @return The height of the page.
+	 */
+	int atlas_packer::get_height()
+	{
+		return this->height;
+	}
+
+	/**
+	 * Gets the height of the page taken up by shelves.
+	 * @return The used height.
+	 */
+	int atlas_packer::get_used_height()
+	{
+		return this->shelves.empty() ? 0 : this->shelves.back().y + this->shelves.back().height;
+	}
+}
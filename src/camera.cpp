@@ -0,0 +1,149 @@
+#include "camera.hpp"
+
+namespace villa
+{
+	constexpr double camera::MAX_ZOOM;
+
+	/**
+	 * Constructor for the Camera class.
+	 * The camera can not be zoomed out further than the zoom at which the world fills the view.
+	 * @param view_width - The width of the view on screen.
+	 * @param view_height - The height of the view on screen.
+	 * @param world_width - The width of the world.
+	 * @param world_height - The height of the world.
+	 */
+	camera::camera(int view_width, int view_height, int world_width, int world_height) : view_width(view_width), view_height(view_height), world_width(world_width), world_height(world_height)
+	{
+		this->min_zoom = std::min(MAX_ZOOM, std::max((double)view_width / world_width, (double)view_height / world_height));
+		reset();
+	}
+
+	/**
+	 * Resets the camera to show the top-left of the world, zoomed out as far as possible.
+	 */
+	void camera::reset()
+	{
+		this->x = 0;
+		this->y = 0;
+		this->zoom = this->min_zoom;
+	}
+
+	/**
+	 * Moves the camera, keeping the view within the world.
+	 * @param x - The distance to move horizontally (screen).
+	 * @param y - The distance to move vertically (screen).
+	 */
+	void camera::pan(double x, double y)
+	{
+		this->x += x / this->zoom;
+		this->y += y / this->zoom;
+
+		clamp();
+	}
+
+	/**
+	 * Zooms the camera, keeping the point of the world under the given screen coords in place.
+	 * @param factor - The amount to multiply the zoom by.
+	 * @param screen_x - The x-coord (screen) to zoom at.
+	 * @param screen_y - The y-coord (screen) to zoom at.
+	 */
+	void camera::zoom_at(double factor, int screen_x, int screen_y)
+	{
+		double world_x = to_world_x(screen_x), world_y = to_world_y(screen_y);
+
+		this->zoom = std::max(this->min_zoom, std::min(MAX_ZOOM, this->zoom * factor));
+		this->x = world_x - screen_x / this->zoom;
+		this->y = world_y - screen_y / this->zoom;
+
+		clamp();
+	}
+
+	/**
+	 * Gets the x-coord (world) of the left edge of the view.
+	 * @return The x-coord of the view.
+	 */
+	double camera::get_x()
+	{
+		return this->x;
+	}
+
+	/**
+	 * Gets the y-coord (world) of the top edge of the view.
+	 * @return The y-coord of the view.
+	 */
+	double camera::get_y()
+	{
+		return this->y;
+	}
+
+	/**
+	 * Gets the zoom of the camera.
+	 * @return The number of screen pixels per world pixel.
+	 */
+	double camera::get_zoom()
+	{
+		return this->zoom;
+	}
+
+	/**
+	 * Transforms a world x-coord into a screen x-coord.
+	 * @param x - The x-coord (world).
+	 * @return The x-coord (screen).
+	 */
+	int camera::to_screen_x(double x)
+	{
+		return (int)std::floor((x - this->x) * this->zoom);
+	}
+
+	/**
+	 * Transforms a world y-coord into a screen y-coord.
+	 * @param y - The y-coord (world).
+	 * @return The y-coord (screen).
+	 */
+	int camera::to_screen_y(double y)
+	{
+		return (int)std::floor((y - this->y) * this->zoom);
+	}
+
+	/**
+	 * Transforms a screen x-coord into a world x-coord.
+	 * @param x - The x-coord (screen).
+	 * @return The x-coord (world).
+	 */
+	double camera::to_world_x(int x)
+	{
+		return x / this->zoom + this->x;
+	}
+
+	/**
+	 * Transforms a screen y-coord into a world y-coord.
+	 * @param y - The y-coord (screen).
+	 * @return The y-coord (world).
+	 */
+	double camera::to_world_y(int y)
+	{
+		return y / this->zoom + this->y;
+	}
+
+	/**
+	 * Checks whether any part of a rectangle of the world is within the view.
+	 * @param x - The x-coord (world) of the rectangle.
+	 * @param y - The y-coord (world) of the rectangle.
+	 * @param width - The width of the rectangle.
+	 * @param height - The height of the rectangle.
+	 * @return Boolean representing whether the rectangle is visible.
+	 */
+	bool camera::is_visible(int x, int y, int width, int height)
+	{
+		return x + width > this->x && y + height > this->y && x < this->x + this->view_width / this->zoom && y < this->y + this->view_height / this->zoom;
+	}
+
+	/**
+	 * Keeps the view within the world.
+	 */
+	void camera::clamp()
+	{
+		this->x = std::max(0.0, std::min(this->x, this->world_width - this->view_width / this->zoom));
+		this->y = std::max(0.0, std::min(this->y, this->world_height - this->view_height / this->zoom));
+	}
+}
@@ -0,0 +1,59 @@
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include "simulation.hpp"
+
+using namespace villa;
+
+/**
+ * Runs a simulation without a window and prints summary statistics.
+ * Usage: Villa-headless [ticks] [seed] [threads]
+ */
+int main(int argc, char *argv[])
+{
+	unsigned long ticks = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 60 * 60 * 10;
+	unsigned int seed = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : time(nullptr);
+	unsigned int threads = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1;
+
+	std::cout << "Running " << ticks << " ticks with seed " << seed << " on " << threads << " threads..." << std::endl;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::unique_ptr<simulation> target(new simulation(seed, threads));
+	std::chrono::steady_clock::time_point generated = std::chrono::steady_clock::now();
+
+	// Run fixed ticks as fast as possible until the tick count is reached or no villagers remain
+	while(target->get_ticks() < ticks && !target->get_finished())
+	{
+		target->tick();
+	}
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	double generate_seconds = std::chrono::duration<double>(generated - start).count();
+	double run_seconds = std::chrono::duration<double>(end - generated).count();
+	map* simulation_map = target->get_map();
+	arenastats allocation = simulation_map->get_allocation_stats();
+
+	std::cout << "Ticks: " << target->get_ticks() << (target->get_finished() ? " (all villagers died)" : "") << std::endl;
+	std::cout << "Simulated time: " << target->get_time() / 1000 << " s" << std::endl;
+	std::cout << "Map generation: " << generate_seconds * 1000 << " ms" << std::endl;
+	std::cout << "Run time: " << run_seconds << " s (" << (run_seconds > 0 ? target->get_ticks() / run_seconds : 0) << " ticks/s)" << std::endl;
+	std::cout << "Villagers: " << simulation_map->get_villagers().size() << std::endl;
+	std::cout << "Buildings: " << simulation_map->get_buildings().size() << std::endl;
+	std::cout << "Resources: " << simulation_map->get_resources().size() << " (food " << simulation_map->get_resource_count(resourcetype::food) << ", tree " << simulation_map->get_resource_count(resourcetype::tree) << ", stone " << simulation_map->get_resource_count(resourcetype::stone) << ", ore " << simulation_map->get_resource_count(resourcetype::ore) << ", grave " << simulation_map->get_resource_count(resourcetype::grave) << ")" << std::endl;
+	std::cout << "State hash: " << std::hex << target->get_state_hash() << std::dec << std::endl;
+	// Print the time spent on each type of job
+	for(unsigned int i = 0; i < job_system::jobtype_count; ++i)
+	{
+		jobstats stats = target->get_jobs()->get_stats(static_cast<jobtype>(i));
+
+		if(stats.jobs > 0)
+		{
+			std::cout << "Jobs (" << job_system::get_jobtype_name(static_cast<jobtype>(i)) << "): " << stats.jobs << " jobs, " << stats.seconds * 1000 << " ms" << std::endl;
+		}
+	}
+
+	std::cout << "Arena: " << allocation.live << " live objects, " << allocation.allocations << " allocations (" << allocation.reused << " reused), " << allocation.reserved / 1024 << " KB reserved" << std::endl;
+
+	return 0;
+}
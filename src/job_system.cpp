@@ -0,0 +1,378 @@
+#include "job_system.hpp"
+
+namespace villa
+{
+	thread_local job_system* job_system::worker_owner = nullptr;
+	thread_local unsigned int job_system::worker_index = 0;
+
+	/**
+	 * Constructor for the Job Counter class.
+	 */
+	job_counter::job_counter() : remaining(0) { }
+
+	/**
+	 * Gets whether all jobs counted by the counter have finished.
+	 * @return Boolean representing whether the jobs have finished.
+	 */
+	bool job_counter::get_finished()
+	{
+		return remaining == 0;
+	}
+
+	/**
+	 * Constructor for the Job System class.
+	 * Queue 0 belongs to the threads that are not workers (e.g. the main thread).
+	 * @param threads - The number of threads to run jobs on, including the calling thread (0 is treated as 1).
+	 */
+	job_system::job_system(unsigned int threads) : queued(0), stopping(false)
+	{
+		threads = threads > 0 ? threads : 1;
+
+		for(unsigned int i = 0; i < jobtype_count; ++i)
+		{
+			stats_jobs[i] = 0;
+			stats_nanoseconds[i] = 0;
+		}
+
+		for(unsigned int i = 0; i < threads; ++i)
+		{
+			queues.push_back(std::unique_ptr<worker_queue>(new worker_queue()));
+		}
+
+		for(unsigned int i = 1; i < threads; ++i)
+		{
+			workers.push_back(std::thread(&job_system::work, this, i));
+		}
+	}
+
+	/**
+	 * Destructor for the Job System class.
+	 * Stops and joins the worker threads. Jobs must not be pending.
+	 */
+	job_system::~job_system()
+	{
+		{
+			std::lock_guard<std::mutex> guard(sleep_lock);
+			stopping = true;
+		}
+
+		wake.notify_all();
+
+		for(std::vector<std::thread>::iterator iterator = workers.begin(); iterator != workers.end(); ++iterator)
+		{
+			iterator->join();
+		}
+	}
+
+	/**
+	 * Gets the number of threads that jobs are run on, including the calling thread.
+	 * @return The number of threads.
+	 */
+	unsigned int job_system::get_thread_count()
+	{
+		return queues.size();
+	}
+
+	/**
+	 * Adds a job to be run.
+	 * @param type - The type of the job.
+	 * @param function - The function to run.
+	 * @param counter - The counter to decrement once the job has run (may be nullptr).
+	 * @param dependency - The counter that must finish before the job is started (may be nullptr).
+	 */
+	void job_system::run(jobtype type, std::function<void()> function, job_counter* counter, job_counter* dependency)
+	{
+		job value = {type, std::move(function), counter, arena::get_current()};
+
+		if(counter != nullptr)
+		{
+			counter->remaining += 1;
+		}
+
+		// Hold the job back until the dependency has finished
+		if(dependency != nullptr)
+		{
+			std::lock_guard<std::mutex> guard(dependency->lock);
+
+			if(dependency->remaining > 0)
+			{
+				dependency->continuations.push_back(std::move(value));
+				return;
+			}
+		}
+
+		push(std::move(value));
+	}
+
+	/**
+	 * Runs jobs until all jobs counted by the counter have finished.
+	 * @param counter - The counter.
+	 */
+	void job_system::wait(job_counter* counter)
+	{
+		unsigned int index = get_index();
+		job value;
+
+		while(counter->remaining > 0)
+		{
+			if(take(index, value))
+			{
+				execute(value);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		// The thread that finished the last job may still hold the lock, so wait for it before the counter goes out of scope
+		std::lock_guard<std::mutex> guard(counter->lock);
+	}
+
+	/**
+	 * Runs the function once for each index from 0 to count - 1, then waits for all iterations to finish.
+	 * Iterations are grouped into jobs of grain iterations, and may run in any order and on any thread,
+	 * so they must not depend on each other.
+	 * @param type - The type of the jobs.
+	 * @param count - The number of iterations.
+	 * @param grain - The number of iterations in each job (0 is treated as 1).
+	 * @param function - The function to run for each index.
+	 */
+	void job_system::parallel_for(jobtype type, std::size_t count, std::size_t grain, const std::function<void(std::size_t)>& function)
+	{
+		job_counter counter;
+		grain = grain > 0 ? grain : 1;
+
+		// Without workers, or with only a single job's worth of iterations, run the loop directly instead of queueing jobs
+		if(workers.empty() || count <= grain)
+		{
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				function(i);
+			}
+
+			record(type, (count + grain - 1) / grain, std::chrono::steady_clock::now() - start);
+
+			return;
+		}
+
+		for(std::size_t first = 0; first < count; first += grain)
+		{
+			std::size_t last = first + grain < count ? first + grain : count;
+
+			run(type, [&function, first, last]()
+			{
+				for(std::size_t i = first; i < last; ++i)
+				{
+					function(i);
+				}
+			}, &counter);
+		}
+
+		wait(&counter);
+	}
+
+	/**
+	 * Gets the timing statistics of the jobs of the type.
+	 * @param type - The type of the jobs.
+	 * @return The timing statistics.
+	 */
+	jobstats job_system::get_stats(jobtype type)
+	{
+		return jobstats{stats_jobs[static_cast<int>(type)], stats_nanoseconds[static_cast<int>(type)] / 1000000000.0};
+	}
+
+	/**
+	 * Resets the timing statistics of all job types.
+	 */
+	void job_system::reset_stats()
+	{
+		for(unsigned int i = 0; i < jobtype_count; ++i)
+		{
+			stats_jobs[i] = 0;
+			stats_nanoseconds[i] = 0;
+		}
+	}
+
+	/**
+	 * Gets the name of the job type.
+	 * @param type - The type of the jobs.
+	 * @return The name of the job type.
+	 */
+	std::string job_system::get_jobtype_name(jobtype type)
+	{
+		switch(type)
+		{
+			case jobtype::general :
+				return "general";
+
+			case jobtype::villager_decision :
+				return "villager decision";
+
+			case jobtype::resource_update :
+				return "resource update";
+
+			case jobtype::map_generation :
+				return "map generation";
+		}
+
+		return "unknown";
+	}
+
+	/**
+	 * Runs jobs on a worker thread until the job system is destroyed.
+	 * @param index - The index of the worker's queue.
+	 */
+	void job_system::work(unsigned int index)
+	{
+		worker_owner = this;
+		worker_index = index;
+		job value;
+
+		while(true)
+		{
+			if(take(index, value))
+			{
+				execute(value);
+			}
+			else
+			{
+				std::unique_lock<std::mutex> guard(sleep_lock);
+				wake.wait(guard, [this]() { return stopping || queued > 0; });
+
+				if(stopping)
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	/**
+	 * Adds the job to the queue of the calling thread and wakes a worker to help run it.
+	 * @param value - The job.
+	 */
+	void job_system::push(job value)
+	{
+		worker_queue* target = queues[get_index()].get();
+
+		{
+			std::lock_guard<std::mutex> guard(target->lock);
+			target->jobs.push_back(std::move(value));
+		}
+
+		queued += 1;
+
+		if(!workers.empty())
+		{
+			// Take the sleep lock so that a worker cannot miss the wake-up between checking the queues and sleeping
+			{
+				std::lock_guard<std::mutex> guard(sleep_lock);
+			}
+
+			wake.notify_one();
+		}
+	}
+
+	/**
+	 * Takes the newest job from the thread's own queue, or steals the oldest job from another queue.
+	 * @param index - The index of the thread's queue.
+	 * @param value - The job taken.
+	 * @return Boolean representing whether a job was taken.
+	 */
+	bool job_system::take(unsigned int index, job& value)
+	{
+		if(queued == 0)
+		{
+			return false;
+		}
+
+		for(unsigned int i = 0; i < queues.size(); ++i)
+		{
+			worker_queue* target = queues[(index + i) % queues.size()].get();
+			std::lock_guard<std::mutex> guard(target->lock);
+
+			if(!target->jobs.empty())
+			{
+				if(i == 0)
+				{
+					value = std::move(target->jobs.back());
+					target->jobs.pop_back();
+				}
+				else
+				{
+					value = std::move(target->jobs.front());
+					target->jobs.pop_front();
+				}
+
+				queued -= 1;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * Runs the job with its arena as the current arena, records its time and finishes it, starting any jobs that depended on its counter.
+	 * @param value - The job.
+	 */
+	void job_system::execute(job& value)
+	{
+		arena* previous = arena::get_current();
+		arena::set_current(value.allocator);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		value.function();
+		record(value.type, 1, std::chrono::steady_clock::now() - start);
+
+		arena::set_current(previous);
+
+		if(value.counter != nullptr)
+		{
+			std::vector<job> continuations;
+
+			{
+				std::lock_guard<std::mutex> guard(value.counter->lock);
+
+				if(value.counter->remaining == 1)
+				{
+					continuations.swap(value.counter->continuations);
+				}
+
+				value.counter->remaining -= 1;
+			}
+
+			for(std::vector<job>::iterator iterator = continuations.begin(); iterator != continuations.end(); ++iterator)
+			{
+				push(std::move(*iterator));
+			}
+		}
+
+		value.function = nullptr;
+	}
+
+	/**
+	 * Adds the jobs to the timing statistics of their type.
+	 * @param type - The type of the jobs.
+	 * @param jobs - The number of jobs.
+	 * @param duration - The time spent running the jobs.
+	 */
+	void job_system::record(jobtype type, unsigned long jobs, std::chrono::steady_clock::duration duration)
+	{
+		stats_jobs[static_cast<int>(type)] += jobs;
+		stats_nanoseconds[static_cast<int>(type)] += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+	}
+
+	/**
+	 * Gets the index of the calling thread's queue.
+	 * @return The index of the queue (0 for threads that are not workers of this job system).
+	 */
+	unsigned int job_system::get_index()
+	{
+		return worker_owner == this ? worker_index : 0;
+	}
+}
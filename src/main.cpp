@@ -4,8 +4,42 @@ using namespace villa;
 
 int main(int argc, char *argv[])
 {
+	// Default to 60 frames per second without vsync, seeding each simulation from the current time
+	// and running it on every hardware thread
+	option_struct options = {60, false, false, 0, std::thread::hardware_concurrency()};
+
+	// Parse the command line options
+	for(int i = 1; i < argc; ++i)
+	{
+		std::string argument = argv[i];
+
+		if(argument == "--fps" && i + 1 < argc)
+		{
+			options.frame_cap = std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if(argument == "--vsync")
+		{
+			options.vsync = true;
+		}
+		else if(argument == "--seed" && i + 1 < argc)
+		{
+			options.fixed_seed = true;
+			options.seed = std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if(argument == "--threads" && i + 1 < argc)
+		{
+			options.threads = std::strtoul(argv[++i], nullptr, 10);
+		}
+		else
+		{
+			std::cerr << "Unknown option: " << argument << std::endl;
+			std::cerr << "Usage: Villa [--fps <frames per second, 0 for no limit>] [--vsync] [--seed <simulation seed>] [--threads <simulation threads>]" << std::endl;
+			return 1;
+		}
+	}
+
 	// Initialize and start the application
-	std::unique_ptr<app> application(new app());
+	std::unique_ptr<app> application(new app(options));
 	application->start();
 
 	return 0;
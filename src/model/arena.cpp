@@ -0,0 +1,367 @@
+#include "arena.hpp"
+
+namespace villa
+{
+	thread_local arena* arena::current = nullptr;
+	thread_local arena::thread_cache arena::cache;
+
+	/**
+	 * Constructor for the Arena class.
+	 * @param chunk_size - The number of bytes to reserve each time the arena runs out of space.
+	 */
+	arena::arena(std::size_t chunk_size) : chunk_size(chunk_size), position(nullptr), limit(nullptr), free_lists(), stats() { }
+
+	/**
+	 * Destructor for the Arena class.
+	 * Releases all chunks at once. Objects allocated from the arena must already be destroyed,
+	 * and no other thread may be using the arena.
+	 */
+	arena::~arena()
+	{
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+
+			// The blocks cached by threads are in the chunks, so the caches are emptied rather than returned
+			for(std::vector<thread_cache*>::const_iterator iterator = this->caches.begin(); iterator != this->caches.end(); ++iterator)
+			{
+				(*iterator)->owner = nullptr;
+				(*iterator)->position = nullptr;
+				(*iterator)->limit = nullptr;
+				(*iterator)->used = 0;
+				(*iterator)->allocations = 0;
+				(*iterator)->deallocations = 0;
+				(*iterator)->reused = 0;
+
+				for(std::size_t i = 0; i < class_count; ++i)
+				{
+					(*iterator)->free_lists[i] = nullptr;
+					(*iterator)->free_counts[i] = 0;
+				}
+			}
+		}
+
+		for(std::vector<char*>::const_iterator iterator = this->chunks.begin(); iterator != this->chunks.end(); ++iterator)
+		{
+			::operator delete(*iterator);
+		}
+
+		if(current == this)
+		{
+			current = nullptr;
+		}
+	}
+
+	/**
+	 * Gets the allocation statistics of the arena, including the blocks handed out by thread caches.
+	 * @return The allocation statistics.
+	 */
+	arenastats arena::get_stats()
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		arenastats value = this->stats;
+
+		for(std::vector<thread_cache*>::const_iterator iterator = this->caches.begin(); iterator != this->caches.end(); ++iterator)
+		{
+			value.used += (*iterator)->used.load(std::memory_order_relaxed);
+			value.allocations += (*iterator)->allocations.load(std::memory_order_relaxed);
+			value.deallocations += (*iterator)->deallocations.load(std::memory_order_relaxed);
+			value.reused += (*iterator)->reused.load(std::memory_order_relaxed);
+		}
+
+		value.live = value.allocations - value.deallocations;
+
+		return value;
+	}
+
+	/**
+	 * Allocates memory for an object.
+	 * Large objects, and objects without an owning arena, are allocated from the heap.
+	 * @param owner - The arena to allocate from (may be nullptr).
+	 * @param size - The size of the object in bytes.
+	 * @return The memory for the object.
+	 */
+	void* arena::allocate(arena* owner, std::size_t size)
+	{
+		std::size_t block_size = (size + header_size + alignment - 1) / alignment * alignment;
+		std::size_t size_class = block_size / alignment - 1;
+		char* block;
+
+		if(owner != nullptr && size_class < class_count)
+		{
+			block = static_cast<char*>(owner->allocate_block(size_class));
+		}
+		else
+		{
+			block = static_cast<char*>(::operator new(block_size));
+			owner = nullptr;
+		}
+
+		header* target = reinterpret_cast<header*>(block);
+		target->owner = owner;
+		target->size_class = size_class;
+
+		return block + header_size;
+	}
+
+	/**
+	 * Deallocates memory previously returned by allocate.
+	 * Arena blocks are returned to the free list of their owning arena for reuse.
+	 * @param value - The memory to deallocate (may be nullptr).
+	 */
+	void arena::deallocate(void* value)
+	{
+		if(value != nullptr)
+		{
+			char* block = static_cast<char*>(value) - header_size;
+			header* target = reinterpret_cast<header*>(block);
+
+			if(target->owner != nullptr)
+			{
+				target->owner->release_block(block, target->size_class);
+			}
+			else
+			{
+				::operator delete(block);
+			}
+		}
+	}
+
+	/**
+	 * Gets the arena that new simulation objects are allocated from on the calling thread.
+	 * @return The current arena (nullptr if objects are allocated from the heap).
+	 */
+	arena* arena::get_current()
+	{
+		return current;
+	}
+
+	/**
+	 * Sets the arena that new simulation objects are allocated from on the calling thread.
+	 * @param value - The arena (nullptr to allocate from the heap).
+	 */
+	void arena::set_current(arena* value)
+	{
+		current = value;
+	}
+
+	/**
+	 * Constructor for the Thread Cache struct.
+	 */
+	arena::thread_cache::thread_cache() : owner(nullptr), free_lists(), free_counts(), position(nullptr), limit(nullptr), used(0), allocations(0), deallocations(0), reused(0) { }
+
+	/**
+	 * Destructor for the Thread Cache struct.
+	 * Returns the cached blocks to their arena when the thread exits.
+	 */
+	arena::thread_cache::~thread_cache()
+	{
+		if(this->owner != nullptr)
+		{
+			this->owner->unbind(*this);
+		}
+	}
+
+	/**
+	 * Gets a block of the size class, reusing a freed block if one is available.
+	 * Blocks come from the calling thread's cache, which is refilled from the arena when it runs out.
+	 * @param size_class - The size class of the block.
+	 * @return The block.
+	 */
+	void* arena::allocate_block(std::size_t size_class)
+	{
+		thread_cache& local = cache;
+		std::size_t block_size = (size_class + 1) * alignment;
+		void* block;
+
+		if(local.owner != this)
+		{
+			bind(local);
+		}
+
+		count(local.allocations, 1);
+
+		if(local.free_lists[size_class] == nullptr && static_cast<std::size_t>(local.limit - local.position) < block_size)
+		{
+			refill(local, size_class);
+		}
+
+		if(local.free_lists[size_class] != nullptr)
+		{
+			block = local.free_lists[size_class];
+			local.free_lists[size_class] = local.free_lists[size_class]->next;
+			local.free_counts[size_class] -= 1;
+			count(local.reused, 1);
+		}
+		else
+		{
+			block = local.position;
+			local.position += block_size;
+			count(local.used, block_size);
+		}
+
+		return block;
+	}
+
+	/**
+	 * Returns a block to the free list of its size class.
+	 * The block is kept by the calling thread if its cache belongs to the arena, and the cache
+	 * returns a batch of blocks to the arena once it holds too many.
+	 * @param block - The block.
+	 * @param size_class - The size class of the block.
+	 */
+	void arena::release_block(void* block, std::size_t size_class)
+	{
+		thread_cache& local = cache;
+		free_block* target = static_cast<free_block*>(block);
+
+		if(local.owner == this)
+		{
+			target->next = local.free_lists[size_class];
+			local.free_lists[size_class] = target;
+			local.free_counts[size_class] += 1;
+			count(local.deallocations, 1);
+
+			if(local.free_counts[size_class] > batch_size * 2)
+			{
+				std::lock_guard<std::mutex> guard(this->lock);
+
+				for(std::size_t i = 0; i < batch_size; ++i)
+				{
+					target = local.free_lists[size_class];
+					local.free_lists[size_class] = target->next;
+					target->next = this->free_lists[size_class];
+					this->free_lists[size_class] = target;
+				}
+
+				local.free_counts[size_class] -= batch_size;
+			}
+		}
+		else
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			target->next = this->free_lists[size_class];
+			this->free_lists[size_class] = target;
+			this->stats.deallocations += 1;
+		}
+	}
+
+	/**
+	 * Makes the thread cache belong to the arena, returning its blocks to the arena it belonged to.
+	 * @param value - The thread cache.
+	 */
+	void arena::bind(thread_cache& value)
+	{
+		if(value.owner != nullptr)
+		{
+			value.owner->unbind(value);
+		}
+
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->caches.push_back(&value);
+		value.owner = this;
+	}
+
+	/**
+	 * Returns the blocks of the thread cache to the arena, and adds its statistics to the arena's.
+	 * Unused space left in the cache is not reused.
+	 * @param value - The thread cache.
+	 */
+	void arena::unbind(thread_cache& value)
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+
+		for(std::size_t i = 0; i < class_count; ++i)
+		{
+			while(value.free_lists[i] != nullptr)
+			{
+				free_block* target = value.free_lists[i];
+				value.free_lists[i] = target->next;
+				target->next = this->free_lists[i];
+				this->free_lists[i] = target;
+			}
+
+			value.free_counts[i] = 0;
+		}
+
+		this->stats.used += value.used.exchange(0, std::memory_order_relaxed);
+		this->stats.allocations += value.allocations.exchange(0, std::memory_order_relaxed);
+		this->stats.deallocations += value.deallocations.exchange(0, std::memory_order_relaxed);
+		this->stats.reused += value.reused.exchange(0, std::memory_order_relaxed);
+
+		this->caches.erase(std::find(this->caches.begin(), this->caches.end(), &value));
+		value.owner = nullptr;
+		value.position = nullptr;
+		value.limit = nullptr;
+	}
+
+	/**
+	 * Refills the thread cache with a batch of freed blocks of the size class,
+	 * or if none have been freed, with a slab of unused space.
+	 * @param value - The thread cache.
+	 * @param size_class - The size class of the block that is needed.
+	 */
+	void arena::refill(thread_cache& value, std::size_t size_class)
+	{
+		std::lock_guard<std::mutex> guard(this->lock);
+		std::size_t block_size = (size_class + 1) * alignment;
+
+		if(this->free_lists[size_class] != nullptr)
+		{
+			for(std::size_t i = 0; i < batch_size && this->free_lists[size_class] != nullptr; ++i)
+			{
+				free_block* target = this->free_lists[size_class];
+				this->free_lists[size_class] = target->next;
+				target->next = value.free_lists[size_class];
+				value.free_lists[size_class] = target;
+				value.free_counts[size_class] += 1;
+			}
+		}
+		else
+		{
+			// Reserve a new chunk if the current one cannot fit the block
+			if(this->position == nullptr || static_cast<std::size_t>(this->limit - this->position) < block_size)
+			{
+				this->position = static_cast<char*>(::operator new(this->chunk_size));
+				this->limit = this->position + this->chunk_size;
+				this->chunks.push_back(this->position);
+				this->stats.chunks += 1;
+				this->stats.reserved += this->chunk_size;
+			}
+
+			std::size_t size = static_cast<std::size_t>(this->limit - this->position);
+			size = size < slab_size ? size : slab_size;
+			value.position = this->position;
+			value.limit = this->position + size;
+			this->position += size;
+		}
+	}
+
+	/**
+	 * Adds to a statistic of a thread cache. Only the cache's thread changes it, so it is not incremented atomically.
+	 * @param value - The statistic.
+	 * @param amount - The amount to add.
+	 */
+	void arena::count(std::atomic<std::size_t>& value, std::size_t amount)
+	{
+		value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	/**
+	 * Allocates the object from the current arena.
+	 * @param size - The size of the object in bytes.
+	 * @return The memory for the object.
+	 */
+	void* arena_allocated::operator new(std::size_t size)
+	{
+		return arena::allocate(arena::get_current(), size);
+	}
+
+	/**
+	 * Returns the object's memory to the arena it was allocated from.
+	 * @param value - The memory of the object.
+	 */
+	void arena_allocated::operator delete(void* value)
+	{
+		arena::deallocate(value);
+	}
+}
@@ -0,0 +1,165 @@
+#include "command_buffer.hpp"
+#include "map.hpp"
+
+namespace villa
+{
+	/**
+	 * Destructor for the Command Buffer class.
+	 * Destroys any entities that were never added to the map.
+	 */
+	command_buffer::~command_buffer()
+	{
+		clear();
+	}
+
+	/**
+	 * Records the building to be added to the map.
+	 * @param value - The building to add.
+	 */
+	void command_buffer::add_building(building* value)
+	{
+		if(value != nullptr)
+		{
+			this->commands.push_back(command{commandtype::add_building, value, handle{0, 0}});
+		}
+	}
+
+	/**
+	 * Records the resource to be added to the map.
+	 * @param value - The resource to add.
+	 */
+	void command_buffer::add_resource(resource* value)
+	{
+		if(value != nullptr)
+		{
+			this->commands.push_back(command{commandtype::add_resource, value, handle{0, 0}});
+		}
+	}
+
+	/**
+	 * Records the villager to be added to the map.
+	 * @param value - The villager to add.
+	 */
+	void command_buffer::add_villager(villager* value)
+	{
+		if(value != nullptr)
+		{
+			this->commands.push_back(command{commandtype::add_villager, value, handle{0, 0}});
+		}
+	}
+
+	/**
+	 * Records the building to be removed from the map.
+	 * @param value - The building to remove.
+	 */
+	void command_buffer::remove_building(building* value)
+	{
+		if(value != nullptr)
+		{
+			this->commands.push_back(command{commandtype::remove_building, nullptr, value->get_handle()});
+		}
+	}
+
+	/**
+	 * Records the resource to be removed from the map.
+	 * @param value - The resource to remove.
+	 */
+	void command_buffer::remove_resource(resource* value)
+	{
+		if(value != nullptr)
+		{
+			this->commands.push_back(command{commandtype::remove_resource, nullptr, value->get_handle()});
+		}
+	}
+
+	/**
+	 * Records the villager to be removed from the map.
+	 * @param value - The villager to remove.
+	 */
+	void command_buffer::remove_villager(villager* value)
+	{
+		if(value != nullptr)
+		{
+			this->commands.push_back(command{commandtype::remove_villager, nullptr, value->get_handle()});
+		}
+	}
+
+	/**
+	 * Applies the recorded changes to the map in the order they were recorded, then empties the buffer.
+	 * @param target - The map to change.
+	 */
+	void command_buffer::apply(map* target)
+	{
+		// Loop through each command in the vector
+		for(std::vector<command>::iterator iterator = this->commands.begin(); iterator != this->commands.end(); ++iterator)
+		{
+			switch(iterator->type)
+			{
+				case commandtype::add_building :
+					target->add_building(static_cast<building*>(iterator->value));
+					break;
+
+				case commandtype::add_resource :
+					target->add_resource(static_cast<resource*>(iterator->value));
+					break;
+
+				case commandtype::add_villager :
+					target->add_villager(static_cast<villager*>(iterator->value));
+					break;
+
+				case commandtype::remove_building :
+					target->remove_building(target->get_building(iterator->target));
+					break;
+
+				case commandtype::remove_resource :
+					target->remove_resource(target->get_resource(iterator->target));
+					break;
+
+				case commandtype::remove_villager :
+					target->remove_villager(target->get_villager(iterator->target));
+					break;
+			}
+		}
+
+		this->commands.clear();
+	}
+
+	/**
+	 * Discards the recorded changes, destroying any entities that were to be added.
+	 */
+	void command_buffer::clear()
+	{
+		// Loop through each command in the vector
+		for(std::vector<command>::iterator iterator = this->commands.begin(); iterator != this->commands.end(); ++iterator)
+		{
+			switch(iterator->type)
+			{
+				case commandtype::add_building :
+					delete static_cast<building*>(iterator->value);
+					break;
+
+				case commandtype::add_resource :
+					delete static_cast<resource*>(iterator->value);
+					break;
+
+				case commandtype::add_villager :
+					delete static_cast<villager*>(iterator->value);
+					break;
+
+				default :
+					break;
+			}
+		}
+
+		this->commands.clear();
+	}
+
+	/**
+	 * Gets the number of recorded changes.
+	 * @return The number of changes.
+	 */
+	int command_buffer::size()
+	{
+		return this->commands.size();
+	}
+}
@@ -1,4 +1,5 @@
 #include "entity.hpp"
+#include <cmath>
 
 namespace villa
 {
@@ -12,7 +13,7 @@ namespace villa
 	 * @param x - The x-coord of the entity.
 	 * @param y - The y-coord of the entity.
 	 */
-	entity::entity(double x, double y, inventory* storage) : x(x), y(y), storage(storage) { }
+	entity::entity(double x, double y, inventory* storage) : x(x), y(y), storage(storage), id{0, 0} { }
 
 	/**
 	 * Destructor for the Entity class.
@@ -75,4 +76,22 @@ namespace villa
 	{
 		return this->storage.get();
 	}
+
+	/**
+	 * Gets the handle of the entity within the map.
+	 * @return The entity handle (default handle if not on a map).
+	 */
+	handle entity::get_handle()
+	{
+		return this->id;
+	}
+
+	/**
+	 * Sets the handle of the entity within the map.
+	 * @param value - The entity handle.
+	 */
+	void entity::set_handle(handle value)
+	{
+		this->id = value;
+	}
 }
@@ -136,6 +136,26 @@ namespace villa
 		return nullptr;
 	}
 
+	/**
+	 * Finds the item with the given id.
+	 * @param id - The item id.
+	 * @return The item (nullptr if it is not in the inventory).
+	 */
+	item* inventory::find_item(unsigned long id)
+	{
+		// Loop through each item in the vector
+		// If we've found the target item, return its pointer (null pointer if none exists)
+		for(std::vector<std::unique_ptr<item>>::iterator iterator = this->items.begin(); iterator != this->items.end(); ++iterator)
+		{
+			if((*iterator)->get_id() == id)
+			{
+				return iterator->get();
+			}
+		}
+
+		return nullptr;
+	}
+
 	/**
 	 * Gets the vector of items.
 	 * @return The item vector.
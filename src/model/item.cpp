@@ -2,16 +2,28 @@
 
 namespace villa
 {
+	// Ids are taken atomically, so that items may be created on any thread
+	std::atomic<unsigned long> item::next_id(1);
+
 	/**
 	 * Constructor for the Item class.
 	 */
-	item::item() : type(itemtype::null) { }
+	item::item() : id(next_id++), type(itemtype::null) { }
 
 	/**
 	 * Constructor for the Item class.
 	 * @param type - The item type.
 	 */
-	item::item(itemtype type) : type(type) { }
+	item::item(itemtype type) : id(next_id++), type(type) { }
+
+	/**
+	 * Gets the id of the item, which is never given to another item.
+	 * @return The item id.
+	 */
+	unsigned long item::get_id()
+	{
+		return this->id;
+	}
 
 	/**
 	 * Gets the type of the item.
@@ -1,15 +1,22 @@
 #include "map.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace villa
 {
 	/**
 	 * Constructor for the Map class.
+	 * @param rng - The random number generator to generate the map from.
+	 * @param rows - Runs the terrain rows, possibly in parallel (empty to generate them on the calling thread).
 	 */
-	map::map(std::mt19937& rng) : rng(rng)
+	map::map(std::mt19937& rng, const loop_runner& rows) : terrain_version(0), rng(rng)
 	{
-		// Seed the Perlin Noise generator
-		PerlinNoise pn(time(nullptr));
+		// Allocate the tiles, entities, items and tasks of this simulation from the map's arena
+		use_allocator();
+
+		// Seed the Perlin Noise generator from the simulation's random number generator,
+		// so that the terrain is reproducible from the simulation seed
+		PerlinNoise pn(rng());
 
 		// Reset the map to contain water tiles
 		for(int i = 0; i < 50; ++i)
@@ -21,8 +28,11 @@ namespace villa
 		}
 
 		// Generate a new map based on the Perlin Noise values
-		for(int i = 2; i < 48; ++i)
+		// Each row only reads the noise and replaces its own tiles, so rows can be generated in any order
+		std::function<void(std::size_t)> generate_row = [this, &pn](std::size_t row)
 		{
+			int i = row + 2;
+
 			for(int j = 3; j < 47; ++j)
 			{
 				double x = (double)j/((double)47) / 8;
@@ -46,6 +56,27 @@ namespace villa
 					this->tiles[i][j].reset(new tile(tiletype::dirt, true));
 				}
 			}
+		};
+
+		if(rows)
+		{
+			rows(46, generate_row);
+		}
+		else
+		{
+			for(std::size_t row = 0; row < 46; ++row)
+			{
+				generate_row(row);
+			}
+		}
+
+		// Work out which texture each tile is displayed with once the terrain is complete
+		for(int i = 0; i < 50; ++i)
+		{
+			for(int j = 0; j < 50; ++j)
+			{
+				update_tile_variant(i, j);
+			}
 		}
 
 		// Scale down random number while preserving uniform distribution
@@ -184,9 +215,19 @@ namespace villa
 					for(int j = (value->get_y() - (value->get_height() * 16)); j <= value->get_y(); j += 16)
 					{
 						get_tile_at(i / 16, j / 16)->set_pathable(false);
+
+						// Resources under the building can no longer be reached
+						std::vector<resource*> targets = get_resources_at(i / 16, j / 16);
+
+						for(std::vector<resource*>::const_iterator iterator = targets.begin(); iterator != targets.end(); ++iterator)
+						{
+							(*iterator)->set_harvestable(false);
+							(*iterator)->set_harvestable_time(0);
+						}
 					}
 				}
-				this->buildings.push_back(std::unique_ptr<building>(value));
+
+				value->set_handle(this->buildings.insert(value));
 			}
 			else
 			{
@@ -203,15 +244,10 @@ namespace villa
 	 */
 	void map::remove_building(building* value)
 	{
-		// Loop through each building in the vector
-		// If we've found the target building, remove it from the vector and stop the loop
-		for(std::vector<std::unique_ptr<building>>::iterator iterator = this->buildings.begin(); iterator != this->buildings.end(); ++iterator)
+		// Only remove the building if its handle refers to it on this map
+		if(value != nullptr && this->buildings.get(value->get_handle()) == value)
 		{
-			if(iterator->get() == value)
-			{
-				this->buildings.erase(iterator);
-				break;
-			}
+			this->buildings.erase(value->get_handle());
 		}
 	}
 
@@ -223,7 +259,22 @@ namespace villa
 	{
 		if(value != nullptr)
 		{
-			this->resources.push_back(std::unique_ptr<resource>(value));
+			value->set_handle(this->resources.insert(value));
+			mark_resource_changed(value);
+
+			int x = value->get_x() / 16, y = value->get_y() / 16;
+
+			if(get_tile_at(x, y) != nullptr)
+			{
+				this->tile_resources[x][y].push_back(value->get_handle());
+
+				// Resources on unpathable terrain can never be reached
+				if(get_tile_at(x, y)->get_pathable() == false)
+				{
+					value->set_harvestable(false);
+					value->set_harvestable_time(0);
+				}
+			}
 		}
 	}
 
@@ -233,15 +284,18 @@ namespace villa
 	 */
 	void map::remove_resource(resource* value)
 	{
-		// Loop through each resource in the vector
-		// If we've found the target resource, remove it from the vector and stop the loop
-		for(std::vector<std::unique_ptr<resource>>::iterator iterator = this->resources.begin(); iterator != this->resources.end(); ++iterator)
+		// Only remove the resource if its handle refers to it on this map
+		if(value != nullptr && this->resources.get(value->get_handle()) == value)
 		{
-			if(iterator->get() == value)
+			int x = value->get_x() / 16, y = value->get_y() / 16;
+
+			if(get_tile_at(x, y) != nullptr)
 			{
-				this->resources.erase(iterator);
-				break;
+				std::vector<handle>& targets = this->tile_resources[x][y];
+				targets.erase(std::remove(targets.begin(), targets.end(), value->get_handle()), targets.end());
 			}
+
+			this->resources.erase(value->get_handle());
 		}
 	}
 
@@ -259,7 +313,7 @@ namespace villa
 
 			if(result == true)
 			{
-				this->villagers.push_back(std::unique_ptr<villager>(value));
+				value->set_handle(this->villagers.insert(value));
 			}
 			else
 			{
@@ -276,70 +330,95 @@ namespace villa
 	 */
 	void map::remove_villager(villager* value)
 	{
-		// Loop through each villager in the vector
-		// If we've found the target villager, remove it from the vector and stop the loop
-		for(std::vector<std::unique_ptr<villager>>::iterator iterator = this->villagers.begin(); iterator != this->villagers.end(); ++iterator)
+		// Only remove the villager if its handle refers to it on this map
+		if(value != nullptr && this->villagers.get(value->get_handle()) == value)
 		{
-			if(iterator->get() == value)
-			{
-				this->villagers.erase(iterator);
-				break;
-			}
+			this->villagers.erase(value->get_handle());
 		}
 	}
 
 	/**
-	 * Gets the vector of buildings.
-	 * @return The building vector.
+	 * Gets a view of the buildings, without copying them.
+	 * The view is invalidated when buildings are added or removed.
+	 * @return The building view.
 	 */
-	std::vector<building*> map::get_buildings()
+	slot_view<building> map::get_buildings()
 	{
-		std::vector<building*> target;
-
-		// Loop through each building in the vector, and pushes to a new vector
-		// Returns the new list of pointers
-		for(std::vector<std::unique_ptr<building>>::const_iterator iterator = this->buildings.begin(); iterator != this->buildings.end(); ++iterator)
-		{
-			target.push_back(iterator->get());
-		}
+		return this->buildings.get_view();
+	}
 
-		return target;
+	/**
+	 * Gets a view of the resources, without copying them.
+	 * The view is invalidated when resources are added or removed.
+	 * @return - The resource view.
+	 */
+	slot_view<resource> map::get_resources()
+	{
+		return this->resources.get_view();
 	}
 
 	/**
-	 * Gets the vector of resources.
-	 * @return - The resource vector.
+	 * Gets a view of the villagers, without copying them.
+	 * The view is invalidated when villagers are added or removed.
+	 * @return The villager view.
 	 */
-	std::vector<resource*> map::get_resources()
+	slot_view<villager> map::get_villagers()
 	{
-		std::vector<resource*> target;
+		return this->villagers.get_view();
+	}
 
-		// Loop through each item in the vector, and pushes to a new vector
-		// Returns the new list of pointers
-		for(std::vector<std::unique_ptr<resource>>::const_iterator iterator = this->resources.begin(); iterator != this->resources.end(); ++iterator)
-		{
-			target.push_back(iterator->get());
-		}
+	/**
+	 * Gets the building with the associated handle.
+	 * @param value - The handle of the building.
+	 * @return The building (nullptr if it has been removed).
+	 */
+	building* map::get_building(handle value)
+	{
+		return this->buildings.get(value);
+	}
 
-		return target;
+	/**
+	 * Gets the resource with the associated handle.
+	 * @param value - The handle of the resource.
+	 * @return The resource (nullptr if it has been removed).
+	 */
+	resource* map::get_resource(handle value)
+	{
+		return this->resources.get(value);
 	}
 
 	/**
-	 * Gets the vector of villagers.
-	 * @return The villager vector.
+	 * Gets the villager with the associated handle.
+	 * @param value - The handle of the villager.
+	 * @return The villager (nullptr if it has been removed).
 	 */
-	std::vector<villager*> map::get_villagers()
+	villager* map::get_villager(handle value)
 	{
-		std::vector<villager*> target;
+		return this->villagers.get(value);
+	}
 
-		// Loop through each item in the vector, and pushes to a new vector
-		// Returns the new list of pointers
-		for(std::vector<std::unique_ptr<villager>>::const_iterator iterator = this->villagers.begin(); iterator != this->villagers.end(); ++iterator)
+	/**
+	 * Gets the entity of the given type with the associated handle.
+	 * @param type - The entity type.
+	 * @param value - The handle of the entity.
+	 * @return The entity (nullptr if it has been removed).
+	 */
+	entity* map::get_entity(entitytype type, handle value)
+	{
+		switch(type)
 		{
-			target.push_back(iterator->get());
-		}
+			case entitytype::villager :
+				return this->villagers.get(value);
 
-		return target;
+			case entitytype::resource :
+				return this->resources.get(value);
+
+			case entitytype::building :
+				return this->buildings.get(value);
+
+			default :
+				return nullptr;
+		}
 	}
 
 	/**
@@ -351,7 +430,7 @@ namespace villa
 	{
 		int quantity = 0;
 
-		for(std::vector<std::unique_ptr<resource>>::const_iterator iterator = this->resources.begin(); iterator != this->resources.end(); ++iterator)
+		for(slot_map<resource>::const_iterator iterator = this->resources.begin(); iterator != this->resources.end(); ++iterator)
 		{
 			if((*iterator)->get_type() == value && (*iterator)->get_harvestable() == true)
 			{
@@ -378,6 +457,138 @@ namespace villa
 		return nullptr;
 	}
 
+	/**
+	 * Sets the type of the tile at the given coordinates.
+	 * Updates the variants of the tile and its neighbours, and records that the terrain has changed.
+	 * @param x - The x-coord of the tile.
+	 * @param y - The y-coord of the tile.
+	 * @param value - The tile type.
+	 */
+	void map::set_tile_type(int x, int y, tiletype value)
+	{
+		if(get_tile_at(x, y) == nullptr)
+		{
+			return;
+		}
+
+		get_tile_at(x, y)->set_type(value);
+
+		for(int i = x - 1; i <= x + 1; ++i)
+		{
+			for(int j = y - 1; j <= y + 1; ++j)
+			{
+				update_tile_variant(i, j);
+			}
+		}
+
+		mark_terrain_changed();
+	}
+
+	/**
+	 * Works out the variant of the tile at the given coordinates from which of its neighbours have a different type.
+	 * Neighbours outside of the map are treated as having the same type.
+	 * @param x - The x-coord of the tile.
+	 * @param y - The y-coord of the tile.
+	 */
+	void map::update_tile_variant(int x, int y)
+	{
+		tile* target = get_tile_at(x, y);
+
+		if(target == nullptr)
+		{
+			return;
+		}
+
+		tiletype type = target->get_type();
+		std::function<bool(int, int)> differs = [this, type](int i, int j)
+		{
+			return get_tile_at(i, j) != nullptr && get_tile_at(i, j)->get_type() != type;
+		};
+
+		// We store the directions which have a different tile type
+		int direction = (differs(x, y - 1) ? 1 : 0) + (differs(x - 1, y) ? 2 : 0) + (differs(x + 1, y) ? 4 : 0) + (differs(x, y + 1) ? 8 : 0);
+
+		switch(direction)
+		{
+			case 1 : // 1 tile (north)
+				target->set_variant(tilevariant::north);
+				break;
+
+			case 2 : // 1 tile (west)
+				target->set_variant(tilevariant::west);
+				break;
+
+			case 3 : // 2 tiles (north, west)
+				target->set_variant(tilevariant::north_west);
+				break;
+
+			case 4 : // 1 tile (east)
+				target->set_variant(tilevariant::east);
+				break;
+
+			case 5 : // 2 tiles (north, east)
+				target->set_variant(tilevariant::north_east);
+				break;
+
+			case 8 : // 1 tile (south)
+				target->set_variant(tilevariant::south);
+				break;
+
+			case 10 : // 2 tiles (south, west)
+				target->set_variant(tilevariant::south_west);
+				break;
+
+			case 12 : // 2 tiles (south, east)
+				target->set_variant(tilevariant::south_east);
+				break;
+
+			default :
+				// Check the diagonal neighbours, in the order the corners have always been chosen
+				if(differs(x - 1, y - 1))
+				{
+					target->set_variant(tilevariant::corner_south_east);
+				}
+				else if(differs(x - 1, y + 1))
+				{
+					target->set_variant(tilevariant::corner_north_east);
+				}
+				else if(differs(x + 1, y - 1))
+				{
+					target->set_variant(tilevariant::corner_north_west);
+				}
+				else if(differs(x + 1, y + 1))
+				{
+					target->set_variant(tilevariant::corner_south_west);
+				}
+				else
+				{
+					target->set_variant(tilevariant::centre);
+				}
+				break;
+		}
+	}
+
+	/**
+	 * Gets the resources on the tile.
+	 * @param x - The x-coords of the tile.
+	 * @param y - The y-coords of the tile.
+	 * @return The resources on the tile (empty if the coords are outside the map).
+	 */
+	std::vector<resource*> map::get_resources_at(int x, int y)
+	{
+		std::vector<resource*> targets;
+
+		if(get_tile_at(x, y) != nullptr)
+		{
+			for(std::vector<handle>::const_iterator iterator = this->tile_resources[x][y].begin(); iterator != this->tile_resources[x][y].end(); ++iterator)
+			{
+				targets.push_back(this->resources.get(*iterator));
+			}
+		}
+
+		return targets;
+	}
+
 	/**
 	 * Gets the coordinates of the given tile.
 	 * @param value - The tile to find.
@@ -452,6 +663,32 @@ namespace villa
 		return neighbors;
 	}
 
+	/**
+	 * Gets the coordinates of the pathable tiles that are neighbours to the target tile.
+	 * Neighbours are ordered as in get_neighbour_tiles (cardinal directions first).
+	 * @param x - The x-coord of the tile.
+	 * @param y - The y-coord of the tile.
+	 * @return The coordinates of the neighbouring tiles.
+	 */
+	std::vector<std::pair<int, int>> map::get_neighbour_coords(int x, int y)
+	{
+		std::vector<std::pair<int, int>> neighbours;
+		const int offsets[8][2] = {{0, -1}, {-1, 0}, {1, 0}, {0, 1}, {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+
+		for(int i = 0; i < 8; ++i)
+		{
+			int target_x = x + offsets[i][0], target_y = y + offsets[i][1];
+
+			// Moving towards the first row or column is never allowed, matching get_neighbour_tiles
+			if((offsets[i][0] == 0 || (target_x > 0 && target_x < 50)) && (offsets[i][1] == 0 || (target_y > 0 && target_y < 50)) && this->tiles[target_x][target_y]->get_pathable() == true)
+			{
+				neighbours.push_back(std::make_pair(target_x, target_y));
+			}
+		}
+
+		return neighbours;
+	}
+
 	/**
 	 * Gets whether there is available space for the building type at a specific location
 	 * @param value - The type of building.
@@ -515,4 +752,82 @@ namespace villa
 
 		return result;
 	}
+
+	/**
+	 * Gets the buffer of structural changes waiting to be applied to the map.
+	 * Entities should be added and removed through the buffer while they are being iterated.
+	 * @return The command buffer.
+	 */
+	command_buffer* map::get_commands()
+	{
+		return &this->commands;
+	}
+
+	/**
+	 * Applies all structural changes waiting in the command buffer.
+	 */
+	void map::apply_commands()
+	{
+		this->commands.apply(this);
+	}
+
+	/**
+	 * Records that the resource may need its harvestable state updated
+	 * (it was added or had items taken).
+	 * @param value - The resource.
+	 */
+	void map::mark_resource_changed(resource* value)
+	{
+		if(value != nullptr)
+		{
+			this->changed_resources.push_back(value->get_handle());
+		}
+	}
+
+	/**
+	 * Gets the resources recorded as changed since the last call, and clears the record.
+	 * @return The handles of the changed resources (may contain duplicates and removed resources).
+	 */
+	std::vector<handle> map::take_changed_resources()
+	{
+		std::vector<handle> target;
+		target.swap(this->changed_resources);
+
+		return target;
+	}
+
+	/**
+	 * Records that the type of one or more tiles has changed, so that any cached display of the terrain is redrawn.
+	 */
+	void map::mark_terrain_changed()
+	{
+		this->terrain_version += 1;
+	}
+
+	/**
+	 * Gets the number of times the terrain has changed since the map was generated.
+	 * @return The terrain version.
+	 */
+	unsigned long map::get_terrain_version()
+	{
+		return this->terrain_version;
+	}
+
+	/**
+	 * Gets the allocation statistics of the map's arena.
+	 * @return The allocation statistics.
+	 */
+	arenastats map::get_allocation_stats()
+	{
+		return this->allocator.get_stats();
+	}
+
+	/**
+	 * Allocates new simulation objects from the map's arena.
+	 * Must be called before changing the map when several maps exist at the same time.
+	 */
+	void map::use_allocator()
+	{
+		arena::set_current(&this->allocator);
+	}
 }
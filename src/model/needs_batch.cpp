@@ -0,0 +1,375 @@
+#include "needs_batch.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VILLA_NEEDS_X86
+#include <immintrin.h>
+#endif
+
+namespace villa
+{
+	/**
+	 * Applies the villager rules to each villager, one villager at a time.
+	 * Villagers with no health remaining are left untouched.
+	 * @param health - The health of each villager.
+	 * @param hunger - The hunger of each villager.
+	 * @param thirst - The thirst of each villager.
+	 * @param fatigue - The fatigue of each villager.
+	 * @param count - The number of villagers.
+	 * @param update_health - Whether to reduce health for villagers with unmet needs.
+	 * @param update_health_regen - Whether to regenerate health.
+	 * @param update_needs - Whether to increase fatigue, hunger and thirst.
+	 */
+	static void update_scalar(int* health, int* hunger, int* thirst, int* fatigue, int count, bool update_health, bool update_health_regen, bool update_needs)
+	{
+		for(int i = 0; i < count; ++i)
+		{
+			if(health[i] <= 0)
+			{
+				continue;
+			}
+
+			if(health[i] > 100)
+			{
+				health[i] = 100;
+			}
+
+			if(fatigue[i] < 0)
+			{
+				fatigue[i] = 0;
+			}
+
+			if(hunger[i] < 0)
+			{
+				hunger[i] = 0;
+			}
+
+			if(thirst[i] < 0)
+			{
+				thirst[i] = 0;
+			}
+
+			// Reduce health by 1 if fatigue, hunger or thirst is above 100
+			if(update_health == true && (fatigue[i] >= 100 || hunger[i] >= 100 || thirst[i] >= 100))
+			{
+				health[i] -= 1;
+			}
+
+			// Increase health by 1
+			if(update_health_regen == true)
+			{
+				health[i] += 1;
+			}
+
+			// Increase fatigue, hunger and thirst by 1
+			if(update_needs == true)
+			{
+				fatigue[i] += 1;
+				hunger[i] += 1;
+				thirst[i] += 1;
+			}
+		}
+	}
+
+#ifdef VILLA_NEEDS_X86
+	/**
+	 * Applies the villager rules to four villagers at a time using SSE2.
+	 * Comparison masks have all bits set (-1) for matching lanes, so adding a mask subtracts 1.
+	 * @see update_scalar
+	 */
+	__attribute__((target("sse2")))
+	static void update_sse2(int* health, int* hunger, int* thirst, int* fatigue, int count, bool update_health, bool update_health_regen, bool update_needs)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i health_max = _mm_set1_epi32(100);
+		const __m128i needs_max = _mm_set1_epi32(99);
+		int i = 0;
+
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128i h = _mm_loadu_si128(reinterpret_cast<__m128i*>(health + i));
+			__m128i hu = _mm_loadu_si128(reinterpret_cast<__m128i*>(hunger + i));
+			__m128i t = _mm_loadu_si128(reinterpret_cast<__m128i*>(thirst + i));
+			__m128i f = _mm_loadu_si128(reinterpret_cast<__m128i*>(fatigue + i));
+			__m128i alive = _mm_cmpgt_epi32(h, zero);
+
+			// Health above 100 implies the villager is alive, so no alive mask is needed
+			__m128i over = _mm_cmpgt_epi32(h, health_max);
+			h = _mm_or_si128(_mm_andnot_si128(over, h), _mm_and_si128(over, health_max));
+
+			f = _mm_andnot_si128(_mm_and_si128(alive, _mm_cmplt_epi32(f, zero)), f);
+			hu = _mm_andnot_si128(_mm_and_si128(alive, _mm_cmplt_epi32(hu, zero)), hu);
+			t = _mm_andnot_si128(_mm_and_si128(alive, _mm_cmplt_epi32(t, zero)), t);
+
+			if(update_health == true)
+			{
+				__m128i unmet = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi32(f, needs_max), _mm_cmpgt_epi32(hu, needs_max)), _mm_cmpgt_epi32(t, needs_max));
+				h = _mm_add_epi32(h, _mm_and_si128(alive, unmet));
+			}
+
+			if(update_health_regen == true)
+			{
+				h = _mm_sub_epi32(h, alive);
+			}
+
+			if(update_needs == true)
+			{
+				f = _mm_sub_epi32(f, alive);
+				hu = _mm_sub_epi32(hu, alive);
+				t = _mm_sub_epi32(t, alive);
+			}
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(health + i), h);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(hunger + i), hu);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(thirst + i), t);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(fatigue + i), f);
+		}
+
+		// Handle the remaining villagers that do not fill a full register
+		update_scalar(health + i, hunger + i, thirst + i, fatigue + i, count - i, update_health, update_health_regen, update_needs);
+	}
+
+	/**
+	 * Applies the villager rules to eight villagers at a time using AVX2.
+	 * @see update_sse2
+	 */
+	__attribute__((target("avx2")))
+	static void update_avx2(int* health, int* hunger, int* thirst, int* fatigue, int count, bool update_health, bool update_health_regen, bool update_needs)
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i health_max = _mm256_set1_epi32(100);
+		const __m256i needs_max = _mm256_set1_epi32(99);
+		int i = 0;
+
+		for(; i + 8 <= count; i += 8)
+		{
+			__m256i h = _mm256_loadu_si256(reinterpret_cast<__m256i*>(health + i));
+			__m256i hu = _mm256_loadu_si256(reinterpret_cast<__m256i*>(hunger + i));
+			__m256i t = _mm256_loadu_si256(reinterpret_cast<__m256i*>(thirst + i));
+			__m256i f = _mm256_loadu_si256(reinterpret_cast<__m256i*>(fatigue + i));
+			__m256i alive = _mm256_cmpgt_epi32(h, zero);
+
+			// Health of villagers with no health remaining is never above 100, so no alive mask is needed
+			h = _mm256_min_epi32(h, health_max);
+
+			f = _mm256_blendv_epi8(f, _mm256_max_epi32(f, zero), alive);
+			hu = _mm256_blendv_epi8(hu, _mm256_max_epi32(hu, zero), alive);
+			t = _mm256_blendv_epi8(t, _mm256_max_epi32(t, zero), alive);
+
+			if(update_health == true)
+			{
+				__m256i unmet = _mm256_or_si256(_mm256_or_si256(_mm256_cmpgt_epi32(f, needs_max), _mm256_cmpgt_epi32(hu, needs_max)), _mm256_cmpgt_epi32(t, needs_max));
+				h = _mm256_add_epi32(h, _mm256_and_si256(alive, unmet));
+			}
+
+			if(update_health_regen == true)
+			{
+				h = _mm256_sub_epi32(h, alive);
+			}
+
+			if(update_needs == true)
+			{
+				f = _mm256_sub_epi32(f, alive);
+				hu = _mm256_sub_epi32(hu, alive);
+				t = _mm256_sub_epi32(t, alive);
+			}
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(health + i), h);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(hunger + i), hu);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(thirst + i), t);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(fatigue + i), f);
+		}
+
+		// Handle the remaining villagers that do not fill a full register
+		update_scalar(health + i, hunger + i, thirst + i, fatigue + i, count - i, update_health, update_health_regen, update_needs);
+	}
+#endif
+
+	/**
+	 * Constructor for the Needs Batch class.
+	 * Selects the fastest kernel supported by the CPU.
+	 */
+	needs_batch::needs_batch() : kernel(get_kernel_best()) { }
+
+	/**
+	 * Removes all villagers from the batch.
+	 * The storage is kept so that the batch can be refilled without reallocating.
+	 */
+	void needs_batch::clear()
+	{
+		this->villagers.clear();
+		this->health.clear();
+		this->hunger.clear();
+		this->thirst.clear();
+		this->fatigue.clear();
+	}
+
+	/**
+	 * Adds the villager to the batch, copying its current stats.
+	 * @param value - The villager to add.
+	 */
+	void needs_batch::add_villager(villager* value)
+	{
+		if(value != nullptr)
+		{
+			this->villagers.push_back(value);
+			this->health.push_back(value->get_health());
+			this->hunger.push_back(value->get_hunger());
+			this->thirst.push_back(value->get_thirst());
+			this->fatigue.push_back(value->get_fatigue());
+		}
+	}
+
+	/**
+	 * Applies the villager rules to every villager in the batch.
+	 * @param update_health - Whether to reduce health for villagers with unmet needs.
+	 * @param update_health_regen - Whether to regenerate health.
+	 * @param update_needs - Whether to increase fatigue, hunger and thirst.
+	 */
+	void needs_batch::update(bool update_health, bool update_health_regen, bool update_needs)
+	{
+		if(!this->villagers.empty())
+		{
+			update(this->health.data(), this->hunger.data(), this->thirst.data(), this->fatigue.data(), this->villagers.size(), update_health, update_health_regen, update_needs, this->kernel);
+		}
+	}
+
+	/**
+	 * Copies the stats in the batch back to each villager.
+	 */
+	void needs_batch::store()
+	{
+		for(std::vector<villager*>::size_type i = 0; i < this->villagers.size(); ++i)
+		{
+			this->villagers[i]->set_health(this->health[i]);
+			this->villagers[i]->set_hunger(this->hunger[i]);
+			this->villagers[i]->set_thirst(this->thirst[i]);
+			this->villagers[i]->set_fatigue(this->fatigue[i]);
+		}
+	}
+
+	/**
+	 * Gets the number of villagers in the batch.
+	 * @return The number of villagers.
+	 */
+	int needs_batch::size()
+	{
+		return this->villagers.size();
+	}
+
+	/**
+	 * Gets the kernel used by the batch.
+	 * @return The kernel.
+	 */
+	needskernel needs_batch::get_kernel()
+	{
+		return this->kernel;
+	}
+
+	/**
+	 * Sets the kernel used by the batch.
+	 * Falls back to the scalar kernel if the CPU does not support the kernel.
+	 * @param value - The kernel.
+	 */
+	void needs_batch::set_kernel(needskernel value)
+	{
+		this->kernel = get_kernel_supported(value) ? value : needskernel::scalar;
+	}
+
+	/**
+	 * Gets whether the CPU supports the kernel.
+	 * @param value - The kernel.
+	 * @return Boolean representing whether the kernel is supported.
+	 */
+	bool needs_batch::get_kernel_supported(needskernel value)
+	{
+		switch(value)
+		{
+			case needskernel::scalar :
+				return true;
+
+#ifdef VILLA_NEEDS_X86
+			case needskernel::sse2 :
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("sse2");
+
+			case needskernel::avx2 :
+				__builtin_cpu_init();
+				return __builtin_cpu_supports("avx2");
+#endif
+
+			default :
+				return false;
+		}
+	}
+
+	/**
+	 * Gets the fastest kernel supported by the CPU.
+	 * @return The kernel.
+	 */
+	needskernel needs_batch::get_kernel_best()
+	{
+		if(get_kernel_supported(needskernel::avx2))
+		{
+			return needskernel::avx2;
+		}
+		else if(get_kernel_supported(needskernel::sse2))
+		{
+			return needskernel::sse2;
+		}
+
+		return needskernel::scalar;
+	}
+
+	/**
+	 * Gets the display name of the kernel.
+	 * @param value - The kernel.
+	 * @return The kernel name.
+	 */
+	std::string needs_batch::get_kernel_name(needskernel value)
+	{
+		switch(value)
+		{
+			case needskernel::sse2 :
+				return "SSE2";
+
+			case needskernel::avx2 :
+				return "AVX2";
+
+			default :
+				return "Scalar";
+		}
+	}
+
+	/**
+	 * Applies the villager rules to arrays of villager stats using the specified kernel.
+	 * The kernel must be supported by the CPU.
+	 * @param health - The health of each villager.
+	 * @param hunger - The hunger of each villager.
+	 * @param thirst - The thirst of each villager.
+	 * @param fatigue - The fatigue of each villager.
+	 * @param count - The number of villagers.
+	 * @param update_health - Whether to reduce health for villagers with unmet needs.
+	 * @param update_health_regen - Whether to regenerate health.
+	 * @param update_needs - Whether to increase fatigue, hunger and thirst.
+	 * @param kernel - The kernel to use.
+	 */
+	void needs_batch::update(int* health, int* hunger, int* thirst, int* fatigue, int count, bool update_health, bool update_health_regen, bool update_needs, needskernel kernel)
+	{
+		switch(kernel)
+		{
+#ifdef VILLA_NEEDS_X86
+			case needskernel::sse2 :
+				update_sse2(health, hunger, thirst, fatigue, count, update_health, update_health_regen, update_needs);
+				break;
+
+			case needskernel::avx2 :
+				update_avx2(health, hunger, thirst, fatigue, count, update_health, update_health_regen, update_needs);
+				break;
+#endif
+
+			default :
+				update_scalar(health, hunger, thirst, fatigue, count, update_health, update_health_regen, update_needs);
+				break;
+		}
+	}
+}
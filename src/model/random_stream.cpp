@@ -0,0 +1,64 @@
+#include "random_stream.hpp"
+
+namespace villa
+{
+	/**
+	 * Constructor for the Random Stream class.
+	 * The key holds the seed and entity index. The counter holds the block number, tick,
+	 * purpose and entity generation, so every (seed, tick, entity, purpose) has its own stream.
+	 * @param seed - The simulation seed.
+	 * @param tick - The current simulation tick.
+	 * @param entity - The handle of the entity making the decision.
+	 * @param purpose - The kind of decision being made.
+	 */
+	random_stream::random_stream(std::uint32_t seed, std::uint32_t tick, handle entity, randompurpose purpose) : key{seed, entity.index}, counter{0, tick, static_cast<std::uint32_t>(purpose), entity.generation}, block{0, 0, 0, 0}, position(4) { }
+
+	/**
+	 * Gets the next random number in the stream.
+	 * Numbers are generated four at a time, one block per counter value.
+	 * @return The random number.
+	 */
+	random_stream::result_type random_stream::operator()()
+	{
+		if(this->position == 4)
+		{
+			philox(this->counter, this->key, this->block);
+			this->counter[0] += 1;
+			this->position = 0;
+		}
+
+		return this->block[this->position++];
+	}
+
+	/**
+	 * Computes the Philox4x32-10 block for the counter and key.
+	 * @param counter - The counter.
+	 * @param key - The key.
+	 * @param result - The four random numbers for the counter.
+	 */
+	void random_stream::philox(const std::uint32_t counter[4], const std::uint32_t key[2], std::uint32_t result[4])
+	{
+		std::uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+		std::uint32_t k0 = key[0], k1 = key[1];
+
+		for(int round = 0; round < 10; ++round)
+		{
+			std::uint64_t product0 = static_cast<std::uint64_t>(0xD2511F53) * c0;
+			std::uint64_t product1 = static_cast<std::uint64_t>(0xCD9E8D57) * c2;
+
+			c0 = static_cast<std::uint32_t>(product1 >> 32) ^ c1 ^ k0;
+			c1 = static_cast<std::uint32_t>(product1);
+			c2 = static_cast<std::uint32_t>(product0 >> 32) ^ c3 ^ k1;
+			c3 = static_cast<std::uint32_t>(product0);
+
+			// Bump the key with the Weyl sequence constants
+			k0 += 0x9E3779B9;
+			k1 += 0xBB67AE85;
+		}
+
+		result[0] = c0;
+		result[1] = c1;
+		result[2] = c2;
+		result[3] = c3;
+	}
+}
@@ -6,35 +6,42 @@ namespace villa
 	 * Constructor for the Task Data struct.
 	 * @param target_coords - The x and y coords to conduct the task.
 	 */
-	taskdata::taskdata(std::pair<int, int> target_coords) : target_coords(target_coords) { }
+	taskdata::taskdata(std::pair<int, int> target_coords) : target_coords(target_coords), target_type(entitytype::null) { }
 
 	/**
 	 * Constructor for the Task Data struct.
 	 * @param target_coords - The x and y coords to conduct the task.
-	 * @param target_entity - The target entity.
+	 * @param target_resource - The target resource (must be on the map).
 	 */
-	taskdata::taskdata(std::pair<int, int> target_coords, entity* target_entity) : target_coords(target_coords), target_entity(target_entity) { }
+	taskdata::taskdata(std::pair<int, int> target_coords, resource* target_resource) : target_coords(target_coords), target_type(entitytype::resource), target_entity(target_resource->get_handle()) { }
 
 	/**
 	 * Constructor for the Task Data struct.
 	 * @param target_coords - The x and y coords to conduct the task.
-	 * @param target_building - The target building.
+	 * @param target_building - The target building (not yet on the map).
 	 */
-	taskdata::taskdata(std::pair<int, int> target_coords, building* target_building) : target_coords(target_coords), target_building(target_building) { }
+	taskdata::taskdata(std::pair<int, int> target_coords, building* target_building) : target_coords(target_coords), target_type(entitytype::building), target_building(target_building) { }
 
 	/**
 	 * Constructor for the Task Data struct.
 	 * @param target_coords - The x and y coords to conduct the task.
-	 * @param target_item - The target item.
+	 * @param target_item - The target building (must be on the map) and item.
 	 */
-	taskdata::taskdata(std::pair<int, int> target_coords, std::pair<entity*, item*> target_item) : target_coords(target_coords), target_item(target_item) { }
+	taskdata::taskdata(std::pair<int, int> target_coords, std::pair<building*, item*> target_item) : target_coords(target_coords), target_type(entitytype::building), target_item(std::make_pair(target_item.first->get_handle(), target_item.second->get_id())) { }
+
+	/**
+	 * Constructor for the Task Data struct.
+	 * @param target_coords - The x and y coords to conduct the task.
+	 * @param target_item - The target resource (must be on the map) and item.
+	 */
+	taskdata::taskdata(std::pair<int, int> target_coords, std::pair<resource*, item*> target_item) : target_coords(target_coords), target_type(entitytype::resource), target_item(std::make_pair(target_item.first->get_handle(), target_item.second->get_id())) { }
 
 	/**
 	 * Constructor for the Task Data struct.
 	 * @param target_coords - The x and y coords to conduct the task.
 	 * @param time - The amount of time to wait.
 	 */
-	taskdata::taskdata(std::pair<int, int> target_coords, int time) : target_coords(target_coords), time(time) { }
+	taskdata::taskdata(std::pair<int, int> target_coords, int time) : target_coords(target_coords), target_type(entitytype::null), time(time) { }
 
 	/**
 	 * Constructor for the Task class.
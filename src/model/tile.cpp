@@ -12,7 +12,7 @@ namespace villa
 	 * @param type - The tile type.
 	 * @param pathable - Boolean representing whether the tile is pathable.
 	 */
-	tile::tile(tiletype type, bool pathable) : type(type), pathable(pathable) { }
+	tile::tile(tiletype type, bool pathable) : type(type), pathable(pathable), variant(tilevariant::centre) { }
 
 	/**
 	 * Gets the type of the tile.
@@ -25,6 +25,7 @@ namespace villa
 
 	/**
 	 * Sets the type of the tile.
+	 * Tiles on a map should be changed through map::set_tile_type, which keeps the variants of the neighbouring tiles up to date.
 	 * @param type - The tile type.
 	 */
 	void tile::set_type(tiletype type)
@@ -49,4 +50,22 @@ namespace villa
 	{
 		this->pathable = value;
 	}
+
+	/**
+	 * Gets the variant of the tile.
+	 * @return The tile variant.
+	 */
+	tilevariant tile::get_variant()
+	{
+		return this->variant;
+	}
+
+	/**
+	 * Sets the variant of the tile.
+	 * @param value - The tile variant.
+	 */
+	void tile::set_variant(tilevariant value)
+	{
+		this->variant = value;
+	}
 }
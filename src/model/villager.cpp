@@ -5,7 +5,7 @@ namespace villa
 	/**
 	 * Constructor for the Villager class.
 	 */
-	villager::villager(double x, double y) : entity(x, y, new inventory()), speed(100), health(100), hunger(0), thirst(0), fatigue(0)
+	villager::villager(double x, double y) : entity(x, y, new inventory()), speed(100), health(100), hunger(0), thirst(0), fatigue(0), previous_x(x), previous_y(y)
 	{
 		add_task(new task(tasktype::idle, taskdata(std::make_pair(x, y))));
 	}
@@ -60,18 +60,17 @@ namespace villa
 
 	/**
 	 * Harvests the target resource.
+	 * @param target - The target resource.
 	 */
-	void villager::harvest()
+	void villager::harvest(resource* target)
 	{
-		taskdata data = get_task()->get_data();
-
 		inventory* inv = get_inventory();
-		inventory* target_inv = data.target_entity->get_inventory();
+		inventory* target_inv = target->get_inventory();
 
 		tool* best_tool = nullptr;
 		int pause_time = 1500;
 
-		switch(static_cast<resource*>(data.target_entity)->get_type())
+		switch(target->get_type())
 		{
 			case resourcetype::water :
 				best_tool = inv->get_tool_highest_efficiency(itemtype::bucket);
@@ -99,7 +98,7 @@ namespace villa
 		set_hunger(get_hunger() + 1);
 		set_thirst(get_thirst() + 2);
 		set_fatigue(get_fatigue() + 3);
-		add_task(new task(tasktype::take_item, taskdata(std::make_pair(x, y), std::make_pair(data.target_entity, target_inv->get_items().back()))));
+		add_task(new task(tasktype::take_item, taskdata(std::make_pair(x, y), std::make_pair(target, target_inv->get_items().back()))));
 	}
 
 	/**
@@ -229,4 +228,31 @@ namespace villa
 	{
 		this->fatigue = value;
 	}
+
+	/**
+	 * Gets the x-coord of the villager at the start of the current tick.
+	 * @return The previous x-coord of the villager.
+	 */
+	double villager::get_previous_x()
+	{
+		return this->previous_x;
+	}
+
+	/**
+	 * Gets the y-coord of the villager at the start of the current tick.
+	 * @return The previous y-coord of the villager.
+	 */
+	double villager::get_previous_y()
+	{
+		return this->previous_y;
+	}
+
+	/**
+	 * Stores the current position as the previous position, at the start of a tick.
+	 */
+	void villager::store_position()
+	{
+		this->previous_x = this->x;
+		this->previous_y = this->y;
+	}
 }
@@ -6,233 +6,688 @@ namespace villa
 	 * Constructor for the Resource Manager class.
 	 * @param renderer - The application renderer.
 	 */
-	resource_manager::resource_manager(SDL_Renderer& renderer) : renderer(renderer) { }
+	resource_manager::resource_manager(SDL_Renderer& renderer) : renderer(renderer), view_x(0.0), view_y(0.0), view_zoom(1.0)
+	{
+		// Handle 0 is reserved for no texture (and no font)
+		textures.push_back(atlas_region{nullptr, SDL_Rect{0, 0, 0, 0}});
+		fonts.push_back(std::unique_ptr<glyph_atlas>());
+	}
 
 	/**
 	 * Unloads all resources in the resource manager.
 	 */
 	void resource_manager::unload_resources()
 	{
-		// Loop through each loaded texture and clean from memory
-		for(std::unordered_map<std::string, SDL_Texture*>::iterator it = textures.begin(); it != textures.end(); ++it)
+		// Loop through each atlas texture and clean from memory
+		for(std::vector<SDL_Texture*>::iterator it = atlases.begin(); it != atlases.end(); ++it)
+		{
+			SDL_DestroyTexture(*it);
+		}
+
+		// Loop through each image that has not been packed into an atlas and clean from memory
+		for(std::vector<std::pair<texture_handle, SDL_Surface*>>::iterator it = images.begin(); it != images.end(); ++it)
+		{
+			SDL_FreeSurface(it->second);
+		}
+
+		atlases.clear();
+		images.clear();
+		textures.resize(1);
+		texture_names.clear();
+
+		// Loop through each cached string and clean from memory
+		for(std::list<text_texture>::iterator it = text_cache.begin(); it != text_cache.end(); ++it)
 		{
-			SDL_DestroyTexture(it->second);
+			if(it->texture != nullptr)
+			{
+				SDL_DestroyTexture(it->texture);
+			}
 		}
 
-		// Loop through each loaded font and clean from memory
-		for(std::unordered_map<std::string, TTF_Font*>::iterator it = fonts.begin(); it != fonts.end(); ++it)
+		text_cache.clear();
+
+		// Loop through each loaded font and its glyph atlas and clean from memory
+		for(std::vector<std::unique_ptr<glyph_atlas>>::iterator it = fonts.begin(); it != fonts.end(); ++it)
 		{
-			TTF_CloseFont(it->second);
+			if(*it)
+			{
+				SDL_DestroyTexture((*it)->texture);
+				SDL_FreeSurface((*it)->surface);
+				TTF_CloseFont((*it)->font);
+			}
 		}
+
+		fonts.resize(1);
+		font_names.clear();
 	}
 
 	/**
 	 * Loads the specified PNG as a texture.
+	 * The texture cannot be rendered until it has been packed into an atlas by build_atlas.
 	 * @param name - The name of the new texture.
 	 * @param path - The filepath of the PNG.
+	 * @return The handle of the texture (0 if the PNG failed to load).
 	 */
-	void resource_manager::load_texture(std::string name, std::string path)
+	texture_handle resource_manager::load_texture(std::string name, std::string path)
 	{
 		SDL_Surface* surface = IMG_Load(path.c_str());
 
 		if(surface == nullptr)
 		{
 			std::cerr << "Failed to load PNG: " << path << "\nSDL_image Error: " << IMG_GetError() << std::endl;
+			return 0;
 		}
-		else
+
+		texture_handle value = textures.size();
+		textures.push_back(atlas_region{nullptr, SDL_Rect{0, 0, surface->w, surface->h}});
+		texture_names[name] = value;
+		images.push_back(std::make_pair(value, surface));
+		std::cout << "Successfully loaded PNG: " << path << std::endl;
+
+		return value;
+	}
+
+	/**
+	 * Creates a texture by drawing several loaded textures into it, so that a sprite made of several parts is drawn with a single blit.
+	 * The parts must have been loaded since the last call to build_atlas, and are drawn in order.
+	 * @param name - The name of the new texture.
+	 * @param parts - The parts of the texture (with non-negative coords).
+	 * @return The handle of the texture (0 if a part is not available).
+	 */
+	texture_handle resource_manager::compose_texture(std::string name, const std::vector<sprite_part>& parts)
+	{
+		int width = 0, height = 0;
+
+		// Find the size of the composite texture from the extent of its parts
+		for(std::vector<sprite_part>::const_iterator it = parts.begin(); it != parts.end(); ++it)
 		{
-			// Create a texture from the surface (supports hardware-based rendering)
-			SDL_Texture* texture = SDL_CreateTextureFromSurface(&renderer, surface);
+			SDL_Surface* image = this->get_image(it->texture);
 
-			if(texture == nullptr)
+			if(image == nullptr || it->x < 0 || it->y < 0)
 			{
-				std::cerr << "Failed to create texture from PNG: " << path << "\nSDL_Error: " << SDL_GetError() << std::endl;
+				std::cerr << "Failed to compose texture from unavailable part: " << name << std::endl;
+				return 0;
+			}
+
+			width = std::max(width, it->x + image->w);
+			height = std::max(height, it->y + image->h);
+		}
+
+		SDL_Surface* surface = create_atlas_surface(std::max(width, 1), std::max(height, 1));
+
+		if(surface == nullptr)
+		{
+			std::cerr << "Failed to create surface for composite texture: " << name << "\nSDL_Error: " << SDL_GetError() << std::endl;
+			return 0;
+		}
+
+		for(std::vector<sprite_part>::const_iterator it = parts.begin(); it != parts.end(); ++it)
+		{
+			SDL_Surface* image = this->get_image(it->texture);
+			SDL_Rect part_rect;
+			part_rect.x = it->x;
+			part_rect.y = it->y;
+
+			// Copy the first part exactly, and blend the later parts over the earlier ones
+			SDL_SetSurfaceBlendMode(image, it == parts.begin() ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+			SDL_BlitSurface(image, nullptr, surface, &part_rect);
+		}
+
+		texture_handle value = textures.size();
+		textures.push_back(atlas_region{nullptr, SDL_Rect{0, 0, surface->w, surface->h}});
+		texture_names[name] = value;
+		images.push_back(std::make_pair(value, surface));
+
+		return value;
+	}
+
+	/**
+	 * Packs the PNGs loaded since the last call into as few atlas textures as possible.
+	 * The atlas textures are created with the current texture filtering hint.
+	 * Drawing from a few large textures lets the renderer batch draws instead of switching textures for each image.
+	 */
+	void resource_manager::build_atlas()
+	{
+		int size = ATLAS_SIZE;
+		SDL_RendererInfo info;
+
+		// Keep the atlas within the largest texture the renderer supports
+		if(SDL_GetRendererInfo(&renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0)
+		{
+			size = std::min(size, std::min(info.max_texture_width, info.max_texture_height));
+		}
+
+		// Pack the tallest images first, so that little space is wasted on each shelf
+		std::vector<std::pair<texture_handle, SDL_Surface*>> remaining;
+		remaining.swap(images);
+		std::stable_sort(remaining.begin(), remaining.end(), [](const std::pair<texture_handle, SDL_Surface*>& a, const std::pair<texture_handle, SDL_Surface*>& b)
+		{
+			return a.second->h > b.second->h;
+		});
+
+		while(!remaining.empty())
+		{
+			// An image larger than the atlas is given an atlas of its own
+			atlas_packer packer(std::max(size, remaining.front().second->w), std::max(size, remaining.front().second->h), 1);
+			std::vector<std::pair<texture_handle, SDL_Surface*>> unpacked;
+			// The index in remaining of each packed image, and its position in the atlas
+			std::vector<std::pair<std::size_t, SDL_Rect>> packed;
+
+			for(std::size_t i = 0; i < remaining.size(); ++i)
+			{
+				SDL_Rect image_rect;
+				image_rect.w = remaining[i].second->w;
+				image_rect.h = remaining[i].second->h;
+
+				if(packer.insert(image_rect.w, image_rect.h, image_rect.x, image_rect.y))
+				{
+					packed.push_back(std::make_pair(i, image_rect));
+				}
+				else
+				{
+					unpacked.push_back(remaining[i]);
+				}
+			}
+
+			// Only allocate as much of the atlas as the packed images cover
+			SDL_Surface* surface = create_atlas_surface(packer.get_width(), packer.get_used_height());
+
+			if(surface == nullptr)
+			{
+				std::cerr << "Failed to create atlas surface! SDL_Error: " << SDL_GetError() << std::endl;
 			}
 			else
 			{
-				textures.insert(std::make_pair(name, texture));
-				std::cout << "Successfully loaded PNG: " << path << std::endl;
+				// Copy each image into the atlas, replacing the transparent background instead of blending with it
+				for(std::vector<std::pair<std::size_t, SDL_Rect>>::iterator it = packed.begin(); it != packed.end(); ++it)
+				{
+					SDL_SetSurfaceBlendMode(remaining[it->first].second, SDL_BLENDMODE_NONE);
+					SDL_BlitSurface(remaining[it->first].second, nullptr, surface, &it->second);
+				}
+
+				// Create a texture from the surface (supports hardware-based rendering)
+				SDL_Texture* texture = SDL_CreateTextureFromSurface(&renderer, surface);
+
+				if(texture == nullptr)
+				{
+					std::cerr << "Failed to create atlas texture! SDL_Error: " << SDL_GetError() << std::endl;
+				}
+				else
+				{
+					SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+					atlases.push_back(texture);
+
+					for(std::vector<std::pair<std::size_t, SDL_Rect>>::iterator it = packed.begin(); it != packed.end(); ++it)
+					{
+						textures[remaining[it->first].first] = atlas_region{texture, it->second};
+					}
+
+					std::cout << "Successfully packed " << packed.size() << " PNGs into a " << surface->w << "x" << surface->h << " atlas." << std::endl;
+				}
+
+				// Free the temporary surface from memory
+				SDL_FreeSurface(surface);
+			}
+
+			// Free the packed images from memory
+			for(std::vector<std::pair<std::size_t, SDL_Rect>>::iterator it = packed.begin(); it != packed.end(); ++it)
+			{
+				SDL_FreeSurface(remaining[it->first].second);
 			}
 
-			// Free the temporary surface from memory
-			SDL_FreeSurface(surface);
+			remaining.swap(unpacked);
 		}
 	}
 
 	/**
-	 * Loads the specified font.
+	 * Loads the specified font, and renders its printable ASCII characters into a glyph atlas.
 	 * @param name - The name of the new font.
 	 * @param path - The filepath of the font.
 	 * @param size - The font size.
+	 * @return The handle of the font (0 if the font or its glyph atlas failed to load).
 	 */
-	void resource_manager::load_font(std::string name, std::string path, int size)
+	font_handle resource_manager::load_font(std::string name, std::string path, int size)
 	{
 		TTF_Font* font = TTF_OpenFont(path.c_str(), size);
 
 		if(font == nullptr)
 		{
 			std::cerr << "Failed to load font: " << path << "\nSDL_TTF Error: " << TTF_GetError() << std::endl;
+			return 0;
 		}
-		else
+
+		std::unique_ptr<glyph_atlas> atlas(new glyph_atlas());
+		atlas->font = font;
+		atlas->texture = nullptr;
+		atlas->surface = nullptr;
+		SDL_Surface* glyphs[glyph_atlas::GLYPH_COUNT];
+
+		// Render each glyph in white, so that the atlas can be drawn in any colour through colour modulation
+		// The width of each glyph's surface is its advance, as when the glyphs were rendered one at a time
+		for(int i = 0; i < glyph_atlas::GLYPH_COUNT; ++i)
+		{
+			char text[2] = {static_cast<char>(glyph_atlas::FIRST_GLYPH + i), '\0'};
+			glyphs[i] = TTF_RenderText_Blended(font, text, SDL_Color{255, 255, 255, 255});
+			atlas->glyphs[i] = SDL_Rect{0, 0, glyphs[i] != nullptr ? glyphs[i]->w : 0, glyphs[i] != nullptr ? glyphs[i]->h : 0};
+
+			for(int j = 0; j < glyph_atlas::GLYPH_COUNT; ++j)
+			{
+				#if SDL_TTF_MAJOR_VERSION > 2 || SDL_TTF_MINOR_VERSION > 0 || SDL_TTF_PATCHLEVEL >= 14
+				atlas->kerning[i][j] = TTF_GetFontKerningSizeGlyphs(font, glyph_atlas::FIRST_GLYPH + i, glyph_atlas::FIRST_GLYPH + j);
+				#else
+				atlas->kerning[i][j] = 0;
+				#endif
+			}
+		}
+
+		// Find the smallest atlas width that fits every glyph
+		for(int width = 256; width <= ATLAS_SIZE; width *= 2)
+		{
+			atlas_packer packer(width, ATLAS_SIZE, 1);
+			bool packed = true;
+
+			for(int i = 0; i < glyph_atlas::GLYPH_COUNT && packed; ++i)
+			{
+				if(glyphs[i] != nullptr)
+				{
+					packed = packer.insert(glyphs[i]->w, glyphs[i]->h, atlas->glyphs[i].x, atlas->glyphs[i].y);
+				}
+			}
+
+			if(packed)
+			{
+				SDL_Surface* surface = create_atlas_surface(packer.get_width(), std::max(packer.get_used_height(), 1));
+
+				if(surface != nullptr)
+				{
+					for(int i = 0; i < glyph_atlas::GLYPH_COUNT; ++i)
+					{
+						if(glyphs[i] != nullptr)
+						{
+							SDL_SetSurfaceBlendMode(glyphs[i], SDL_BLENDMODE_NONE);
+							SDL_BlitSurface(glyphs[i], nullptr, surface, &atlas->glyphs[i]);
+						}
+					}
+
+					atlas->texture = SDL_CreateTextureFromSurface(&renderer, surface);
+					atlas->surface = surface;
+				}
+
+				break;
+			}
+		}
+
+		// Free the temporary glyph surfaces from memory
+		for(int i = 0; i < glyph_atlas::GLYPH_COUNT; ++i)
+		{
+			SDL_FreeSurface(glyphs[i]);
+		}
+
+		if(atlas->texture == nullptr)
 		{
-			fonts.insert(std::make_pair(name + std::to_string(size), font));
-			std::cout << "Successfully loaded font: " << path << std::endl;
+			std::cerr << "Failed to create glyph atlas for font: " << path << "\nSDL_Error: " << SDL_GetError() << std::endl;
+			SDL_FreeSurface(atlas->surface);
+			TTF_CloseFont(font);
+			return 0;
 		}
+
+		SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+
+		font_handle value = fonts.size();
+		fonts.push_back(std::move(atlas));
+		font_names[std::make_pair(name, size)] = value;
+		std::cout << "Successfully loaded font: " << path << std::endl;
+
+		return value;
+	}
+
+	/**
+	 * Sets the view that textures are rendered through, so that world positions can be passed to render_texture.
+	 * @param x - The world x-coord at the left of the screen.
+	 * @param y - The world y-coord at the top of the screen.
+	 * @param zoom - The number of screen pixels per world pixel.
+	 */
+	void resource_manager::set_view(double x, double y, double zoom)
+	{
+		view_x = x;
+		view_y = y;
+		view_zoom = zoom;
+	}
+
+	/**
+	 * Resets the view so that textures are rendered at screen positions.
+	 */
+	void resource_manager::reset_view()
+	{
+		this->set_view(0.0, 0.0, 1.0);
+	}
+
+	/**
+	 * Gets the screen rectangle of a world rectangle through the view.
+	 * Both edges are rounded down, so that neighbouring rectangles stay gapless when zoomed.
+	 * @param x - The world x-coord of the rectangle.
+	 * @param y - The world y-coord of the rectangle.
+	 * @param width - The world width of the rectangle.
+	 * @param height - The world height of the rectangle.
+	 * @return The screen rectangle.
+	 */
+	SDL_Rect resource_manager::get_view_rect(int x, int y, int width, int height)
+	{
+		SDL_Rect value;
+		value.x = static_cast<int>(std::floor((x - view_x) * view_zoom));
+		value.y = static_cast<int>(std::floor((y - view_y) * view_zoom));
+		value.w = static_cast<int>(std::floor((x + width - view_x) * view_zoom)) - value.x;
+		value.h = static_cast<int>(std::floor((y + height - view_y) * view_zoom)) - value.y;
+
+		return value;
 	}
 
 	/**
-	 * Renders a texture on screen.
+	 * Renders a texture on screen, through the current view.
 	 * @param x - The x-coord of the texture.
 	 * @param y - The y-coord of the texture.
-	 * @param name - The texture name.
+	 * @param value - The texture handle.
 	 */
-	void resource_manager::render_texture(int x, int y, std::string name)
+	void resource_manager::render_texture(int x, int y, texture_handle value)
 	{
-		SDL_Texture* texture = this->get_texture(name);
+		atlas_region* region = this->get_texture(value);
 
-		if(texture != nullptr)
+		if(region != nullptr)
 		{
 			// Set the x, y, width and height of the texture
-			// The width and height are automatically queried from the texture
-			SDL_Rect texture_rect;
-			texture_rect.x = x;
-			texture_rect.y = y;
-			SDL_QueryTexture(texture, nullptr, nullptr, &texture_rect.w, &texture_rect.h);
+			// The width and height are taken from the texture's region of the atlas
+			SDL_Rect texture_rect = this->get_view_rect(x, y, region->rect.w, region->rect.h);
 
-			SDL_RenderCopy(&renderer, texture, nullptr, &texture_rect);
+			SDL_RenderCopy(&renderer, region->texture, &region->rect, &texture_rect);
 		}
 	}
 
 	/**
 	 * Renders a string of text on screen.
+	 * The string is rendered into a cached texture the first time it is used with the font, so that drawing it again is a single blit.
+	 * Characters outside of the printable ASCII range are skipped.
 	 * @param x - The x-coord of the text.
 	 * @param y - The y-coord of the text.
 	 * @param text - The text to render.
-	 * @param font - The font name.
-	 * @param size - The font size.
+	 * @param font - The font handle.
+	 * @param color - The colour of the text.
 	 */
-	void resource_manager::render_text(int x, int y, std::string text, std::string font, int size, SDL_Color color)
+	void resource_manager::render_text(int x, int y, const std::string& text, font_handle font, SDL_Color color)
 	{
-		int new_x = x;
+		glyph_atlas* atlas = this->get_font(font);
 
-		// Loop through each character in the string
-		for(char& c : text)
+		if(atlas == nullptr || text.empty())
 		{
-			SDL_Texture* texture = this->get_texture_text(std::string(1, c), font, size, color);
+			return;
+		}
 
-			if(texture != nullptr)
+		text_texture* cached = this->get_text_texture(text, font);
+
+		// The cached string and the glyphs are white, so tint them with the text colour
+		if(cached->texture != nullptr)
+		{
+			SDL_Rect texture_rect;
+			texture_rect.x = x;
+			texture_rect.y = y;
+			texture_rect.w = cached->width;
+			texture_rect.h = cached->height;
+
+			SDL_SetTextureColorMod(cached->texture, color.r, color.g, color.b);
+			SDL_RenderCopy(&renderer, cached->texture, nullptr, &texture_rect);
+		}
+		// If the string could not be cached, draw each glyph from the atlas instead
+		else
+		{
+			std::vector<std::pair<int, int>> layout = this->layout_text(text, atlas);
+
+			SDL_SetTextureColorMod(atlas->texture, color.r, color.g, color.b);
+
+			for(std::vector<std::pair<int, int>>::iterator it = layout.begin(); it != layout.end(); ++it)
 			{
-				// Set the x, y, width and height of the texture
-				// The width and height are automatically queried from the texture
 				SDL_Rect texture_rect;
-				texture_rect.x = new_x;
+				texture_rect.x = x + it->second;
 				texture_rect.y = y;
-				SDL_QueryTexture(texture, nullptr, nullptr, &texture_rect.w, &texture_rect.h);
-
-				SDL_RenderCopy(&renderer, texture, nullptr, &texture_rect);
+				texture_rect.w = atlas->glyphs[it->first].w;
+				texture_rect.h = atlas->glyphs[it->first].h;
 
-				// Set the new x-coord for the next letter
-				new_x += texture_rect.w;
+				SDL_RenderCopy(&renderer, atlas->texture, &atlas->glyphs[it->first], &texture_rect);
 			}
 		}
 	}
 
 	/**
-	 * Gets the texture with the associated name.
+	 * Gets the handle of the texture with the associated name.
+	 * Intended to be called once when loading, rather than each time the texture is rendered.
 	 * @param name - The name of the texture.
-	 * @return The texture (nullptr if not found).
+	 * @return The texture handle (0 if not found).
 	 */
-	SDL_Texture* resource_manager::get_texture(std::string name)
+	texture_handle resource_manager::get_texture_handle(std::string name)
 	{
 		// Search through the loaded textures for the target texture
-		std::unordered_map<std::string, SDL_Texture*>::iterator target = textures.find(name);
+		std::unordered_map<std::string, texture_handle>::iterator target = texture_names.find(name);
 
-		// If the target texture is found, return its pointer
-		if(target != textures.end())
+		// If the target texture is found, return its handle
+		if(target != texture_names.end())
 		{
 			return target->second;
 		}
 
 		std::cerr << "Attempted to use texture that has not been loaded: " << name << std::endl;
+		return 0;
+	}
+
+	/**
+	 * Gets the atlas region of the texture.
+	 * Textures that failed to load were reported when loading, so they are skipped silently.
+	 * @param value - The texture handle.
+	 * @return The atlas region (nullptr if the texture is not loaded or not yet packed into an atlas).
+	 */
+	atlas_region* resource_manager::get_texture(texture_handle value)
+	{
+		if(value < textures.size() && textures[value].texture != nullptr)
+		{
+			return &textures[value];
+		}
+
 		return nullptr;
 	}
 
 	/**
-	 * Gets the texture that displays the associated text.
-	 * If the texture does not exist, it is created.
-	 * @param text - The text to display.
-	 * @param font - The font name.
+	 * Gets the handle of the font with the associated name and size.
+	 * Intended to be called once when loading, rather than each time text is rendered.
+	 * @param name - The name of the font.
 	 * @param size - The font size.
-	 * @return The texture (nullptr if texture creation fails).
+	 * @return The font handle (0 if not found).
 	 */
-	SDL_Texture* resource_manager::get_texture_text(std::string text, std::string font, int size, SDL_Color color)
+	font_handle resource_manager::get_font_handle(std::string name, int size)
 	{
-		// Search through the loaded textures for the target texture
-		std::unordered_map<std::string, SDL_Texture*>::iterator target = textures_text.find(text + font + std::to_string(color.r) + std::to_string(color.g) + std::to_string(color.b));
+		// Search through the loaded fonts for the target font
+		std::map<std::pair<std::string, int>, font_handle>::iterator target = font_names.find(std::make_pair(name, size));
 
-		// If the target texture is found, return its pointer
-		if(target != textures_text.end())
+		// If the target font is found, return its handle
+		if(target != font_names.end())
 		{
 			return target->second;
 		}
-		// If the target texture is not found, create it and return its pointer
-		else
+
+		std::cerr << "Attempted to use font that has not been loaded: \nFont: " << name << "\nSize: " << std::to_string(size) << std::endl;
+		return 0;
+	}
+
+	/**
+	 * Gets the glyph atlas of the font.
+	 * @param value - The font handle.
+	 * @return The glyph atlas (nullptr if the font is not loaded).
+	 */
+	glyph_atlas* resource_manager::get_font(font_handle value)
+	{
+		if(value < fonts.size())
+		{
+			return fonts[value].get();
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * Creates an empty, transparent surface to copy images into before creating an atlas texture.
+	 * @param width - The width of the surface.
+	 * @param height - The height of the surface.
+	 * @return The surface (nullptr if surface creation fails).
+	 */
+	SDL_Surface* resource_manager::create_atlas_surface(int width, int height)
+	{
+		#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+		return SDL_CreateRGBSurface(0, width, height, 32, 0xFF000000, 0x00FF0000, 0x0000FF00, 0x000000FF);
+		#else
+		return SDL_CreateRGBSurface(0, width, height, 32, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
+		#endif
+	}
+
+	/**
+	 * Gets the position of each glyph of a string.
+	 * Characters outside of the printable ASCII range are skipped.
+	 * @param text - The text.
+	 * @param atlas - The glyph atlas of the font.
+	 * @return The index of each glyph in the atlas, and its x-coord relative to the start of the string.
+	 */
+	std::vector<std::pair<int, int>> resource_manager::layout_text(const std::string& text, glyph_atlas* atlas)
+	{
+		std::vector<std::pair<int, int>> layout;
+		int new_x = 0, previous = -1;
+
+		// Loop through each character in the string
+		for(std::string::const_iterator it = text.begin(); it != text.end(); ++it)
 		{
-			TTF_Font* fontface = this->get_font(font, size);
+			int index = static_cast<unsigned char>(*it) - glyph_atlas::FIRST_GLYPH;
 
-			// If there's text and the font is loaded...
-			if(!text.empty() && fontface != nullptr)
+			if(index < 0 || index >= glyph_atlas::GLYPH_COUNT)
 			{
-				// Create a surface that displays the text
-				SDL_Surface* surface = TTF_RenderText_Blended(fontface, text.c_str(), color);
+				previous = -1;
+				continue;
+			}
 
-				if(surface == nullptr)
-				{
-					std::cerr << "Failed to create surface from text: \nText: " << text << "\nFont: " << font << "\nSDL_TTF Error: " << TTF_GetError() << std::endl;
-				}
-				else
-				{
-					// Create a texture from the surface (supports hardware-based rendering)
-					SDL_Texture* texture = SDL_CreateTextureFromSurface(&renderer, surface);
+			if(previous >= 0)
+			{
+				new_x += atlas->kerning[previous][index];
+			}
 
-					if(texture == nullptr)
-					{
-						std::cerr << "Failed to create texture from text: \nText: " << text << "\nFont: " << font << "\nSDL_TTF Error: " << TTF_GetError() << std::endl;
-					}
-					else
-					{
-						textures_text.insert(std::make_pair(text + font + std::to_string(color.r) + std::to_string(color.g) + std::to_string(color.b), texture));
-						return texture;
-					}
+			layout.push_back(std::make_pair(index, new_x));
 
-					// Free the temporary surface from memory
-					SDL_FreeSurface(surface);
-				}
+			// Set the new x-coord for the next letter
+			new_x += atlas->glyphs[index].w;
+			previous = index;
+		}
+
+		return layout;
+	}
+
+	/**
+	 * Gets the cached texture of a string rendered with the font, creating it if the string is not cached.
+	 * Once the cache is full, the least recently rendered string is removed.
+	 * @param text - The text.
+	 * @param font - The font handle (must refer to a loaded font).
+	 * @return The cached string.
+	 */
+	text_texture* resource_manager::get_text_texture(const std::string& text, font_handle font)
+	{
+		glyph_atlas* atlas = fonts[font].get();
+		std::unordered_map<std::string, std::list<text_texture>::iterator>::iterator target = atlas->texts.find(text);
+
+		// If the string is cached, move it to the front of the cache as the most recently rendered string
+		if(target != atlas->texts.end())
+		{
+			text_cache.splice(text_cache.begin(), text_cache, target->second);
+			return &text_cache.front();
+		}
+
+		// Remove the least recently rendered string if the cache is full
+		if(text_cache.size() >= TEXT_CACHE_SIZE)
+		{
+			text_texture& oldest = text_cache.back();
+
+			if(oldest.texture != nullptr)
+			{
+				SDL_DestroyTexture(oldest.texture);
 			}
 
-			std::cerr << "Attempted to create texture from invalid text/font: \nText: " << text << "\nFont: " << font << "\nSize: " << std::to_string(size) << std::endl;
-			return nullptr;
+			fonts[oldest.font]->texts.erase(oldest.text);
+			text_cache.pop_back();
 		}
+
+		text_cache.push_front(text_texture{text, font, nullptr, 0, 0});
+		atlas->texts[text] = text_cache.begin();
+		create_text_texture(text_cache.front());
+
+		return &text_cache.front();
 	}
 
 	/**
-	 * Gets the font with the associated name.
-	 * @param name - The name of the font.
-	 * @param size - The font size.
-	 * @return The font (nullptr if not found).
+	 * Renders a string in white from the glyph atlas of its font into a new texture.
+	 * @param value - The cached string (its texture is left as nullptr if texture creation fails).
 	 */
-	TTF_Font* resource_manager::get_font(std::string name, int size)
+	void resource_manager::create_text_texture(text_texture& value)
 	{
-		// Search through the loaded fonts for the target font
-		std::unordered_map<std::string, TTF_Font*>::iterator target = fonts.find(name + std::to_string(size));
+		glyph_atlas* atlas = fonts[value.font].get();
+		std::vector<std::pair<int, int>> layout = this->layout_text(value.text, atlas);
 
-		// If the target font is found, return its pointer
-		if(target != fonts.end())
+		for(std::vector<std::pair<int, int>>::iterator it = layout.begin(); it != layout.end(); ++it)
 		{
-			return target->second;
+			value.width = std::max(value.width, it->second + atlas->glyphs[it->first].w);
+			value.height = std::max(value.height, atlas->glyphs[it->first].h);
+		}
+
+		if(value.width <= 0 || value.height <= 0)
+		{
+			return;
+		}
+
+		SDL_Surface* surface = create_atlas_surface(value.width, value.height);
+
+		if(surface == nullptr)
+		{
+			return;
+		}
+
+		// Start from transparent white, so that blending the glyphs keeps the colour white where they overlap
+		SDL_FillRect(surface, nullptr, SDL_MapRGBA(surface->format, 255, 255, 255, 0));
+		SDL_SetSurfaceBlendMode(atlas->surface, SDL_BLENDMODE_BLEND);
+
+		for(std::vector<std::pair<int, int>>::iterator it = layout.begin(); it != layout.end(); ++it)
+		{
+			SDL_Rect texture_rect = atlas->glyphs[it->first];
+			texture_rect.x = it->second;
+			texture_rect.y = 0;
+
+			SDL_BlitSurface(atlas->surface, &atlas->glyphs[it->first], surface, &texture_rect);
+		}
+
+		value.texture = SDL_CreateTextureFromSurface(&renderer, surface);
+
+		if(value.texture != nullptr)
+		{
+			SDL_SetTextureBlendMode(value.texture, SDL_BLENDMODE_BLEND);
+		}
+
+		// Free the temporary surface from memory
+		SDL_FreeSurface(surface);
+	}
+
+	/**
+	 * Gets the image of a texture that has not yet been packed into an atlas.
+	 * @param value - The texture handle.
+	 * @return The image (nullptr if not found).
+	 */
+	SDL_Surface* resource_manager::get_image(texture_handle value)
+	{
+		for(std::vector<std::pair<texture_handle, SDL_Surface*>>::iterator it = images.begin(); it != images.end(); ++it)
+		{
+			if(it->first == value)
+			{
+				return it->second;
+			}
 		}
 
-		std::cerr << "Attempted to use font that has not been loaded: \nFont: " << name << "\nSize: " << std::to_string(size) << std::endl;
 		return nullptr;
 	}
 }
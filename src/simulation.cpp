@@ -0,0 +1,441 @@
+#include "simulation.hpp"
+
+namespace villa
+{
+	/**
+	 * Constructor for the Simulation class.
+	 * Generates a new map populated with villagers.
+	 * @param seed - The seed for the random number generator.
+	 * @param threads - The number of threads to run villager decisions on.
+	 */
+	simulation::simulation(unsigned int seed, unsigned int threads) : seed(seed), rng(seed), jobs(threads), ticks(0)
+	{
+		// Generate the terrain rows on the job system
+		simulation_map.reset(new map(rng, [this](std::size_t count, const std::function<void(std::size_t)>& function)
+		{
+			jobs.parallel_for(jobtype::map_generation, count, MAP_GENERATION_GRAIN, function);
+		}));
+		simulation_ai.reset(new ai_manager(simulation_map.get(), &jobs, seed));
+
+		timers.time = timers.villager_health = timers.villager_health_regen = timers.villager_needs = 0;
+	}
+
+	/**
+	 * Advances the simulation by a single fixed tick.
+	 * Structural changes made by each phase are applied once the phase has finished iterating.
+	 */
+	void simulation::tick()
+	{
+		simulation_map->use_allocator();
+
+		// Keep the positions from before the tick, so that movement can be displayed between ticks
+		simulation_map->for_each_villager([](villager* value)
+		{
+			value->store_position();
+		});
+
+		update();
+		simulation_map->apply_commands();
+		simulation_ai->think(ticks);
+		simulation_map->apply_commands();
+
+		timers.time += UPDATE_TIME;
+		ticks += 1;
+	}
+
+	/**
+	 * Gets whether the simulation has ended (no villagers remain).
+	 * @return Boolean representing whether the simulation has ended.
+	 */
+	bool simulation::get_finished()
+	{
+		return simulation_map->get_villagers().empty();
+	}
+
+	/**
+	 * Gets the simulated time.
+	 * @return The simulated time in milliseconds.
+	 */
+	unsigned int simulation::get_time()
+	{
+		return timers.time;
+	}
+
+	/**
+	 * Gets the number of ticks that have been run.
+	 * @return The number of ticks.
+	 */
+	unsigned long simulation::get_ticks()
+	{
+		return ticks;
+	}
+
+	/**
+	 * Gets the seed the simulation was created with.
+	 * @return The seed.
+	 */
+	unsigned int simulation::get_seed()
+	{
+		return seed;
+	}
+
+	/**
+	 * Gets a hash of the simulation state (FNV-1a over time, villagers, resources and buildings).
+	 * Runs with the same seed and inputs produce the same hash after the same number of ticks.
+	 * @return The state hash.
+	 */
+	std::uint64_t simulation::get_state_hash()
+	{
+		std::uint64_t hash = 14695981039346656037ULL;
+
+		hash_bytes(hash, &timers.time, sizeof(timers.time));
+		hash_bytes(hash, &ticks, sizeof(ticks));
+
+		slot_view<villager> villagers = simulation_map->get_villagers();
+
+		// Loop through each villager in the vector
+		for(slot_view<villager>::iterator iterator = villagers.begin(); iterator != villagers.end(); ++iterator)
+		{
+			double x = (*iterator)->get_x(), y = (*iterator)->get_y();
+			int values[] = {(*iterator)->get_health(), (*iterator)->get_hunger(), (*iterator)->get_thirst(), (*iterator)->get_fatigue(), (*iterator)->get_task_count(), (int)(*iterator)->get_task()->get_type(), (*iterator)->get_inventory()->get_item_count()};
+
+			hash_bytes(hash, &x, sizeof(x));
+			hash_bytes(hash, &y, sizeof(y));
+			hash_bytes(hash, values, sizeof(values));
+		}
+
+		slot_view<resource> resources = simulation_map->get_resources();
+
+		// Loop through each resource in the vector
+		for(slot_view<resource>::iterator iterator = resources.begin(); iterator != resources.end(); ++iterator)
+		{
+			double x = (*iterator)->get_x(), y = (*iterator)->get_y();
+			unsigned int values[] = {(unsigned int)(*iterator)->get_type(), (*iterator)->get_harvestable(), (*iterator)->get_harvestable_time(), (unsigned int)(*iterator)->get_inventory()->get_item_count()};
+
+			hash_bytes(hash, &x, sizeof(x));
+			hash_bytes(hash, &y, sizeof(y));
+			hash_bytes(hash, values, sizeof(values));
+		}
+
+		slot_view<building> buildings = simulation_map->get_buildings();
+
+		// Loop through each building in the vector
+		for(slot_view<building>::iterator iterator = buildings.begin(); iterator != buildings.end(); ++iterator)
+		{
+			double x = (*iterator)->get_x(), y = (*iterator)->get_y();
+			int values[] = {(int)(*iterator)->get_type(), (*iterator)->get_inventory()->get_item_count()};
+
+			hash_bytes(hash, &x, sizeof(x));
+			hash_bytes(hash, &y, sizeof(y));
+			hash_bytes(hash, values, sizeof(values));
+		}
+
+		return hash;
+	}
+
+	/**
+	 * Copies the state that is displayed into the snapshot, reusing its storage.
+	 * The tiles are only copied when the terrain has changed since the snapshot last copied them.
+	 * @param value - The snapshot.
+	 */
+	void simulation::take_snapshot(simulation_snapshot& value)
+	{
+		value.ticks = ticks;
+		value.time = timers.time;
+		value.finished = get_finished();
+		value.villagers.clear();
+		value.resources.clear();
+		value.buildings.clear();
+
+		for(int i = 0; i < 6; ++i)
+		{
+			value.resource_counts[i] = 0;
+		}
+
+		if(value.terrain_version != simulation_map->get_terrain_version())
+		{
+			value.terrain_version = simulation_map->get_terrain_version();
+
+			for(int i = 0; i < 50; ++i)
+			{
+				for(int j = 0; j < 50; ++j)
+				{
+					tile* target = simulation_map->get_tile_at(i, j);
+					value.tiles[i][j] = tile_snapshot{target->get_type(), target->get_variant()};
+				}
+			}
+		}
+
+		// The texture variants are taken from the entity addresses, which do not change while the entities exist
+		simulation_map->for_each_villager([&value](villager* target)
+		{
+			value.villagers.push_back(villager_snapshot{target->get_x(), target->get_y(), target->get_previous_x(), target->get_previous_y(), std::hash<villager*>{}(target)});
+		});
+
+		// Copy the resources one row of tiles at a time, so that the resources near the view can be found by row
+		for(int j = 0; j < 50; ++j)
+		{
+			value.resource_rows[j] = value.resources.size();
+
+			simulation_map->for_each_resource_in(0, j, 49, j, [&value](resource* target)
+			{
+				value.resources.push_back(resource_snapshot{target->get_x(), target->get_y(), target->get_type(), target->get_harvestable(), std::hash<resource*>{}(target)});
+
+				if(target->get_harvestable() == true)
+				{
+					value.resource_counts[static_cast<int>(target->get_type())] += 1;
+				}
+			});
+		}
+
+		value.resource_rows[50] = value.resources.size();
+
+		slot_view<building> buildings = simulation_map->get_buildings();
+
+		// Loop through each building in the vector
+		for(slot_view<building>::iterator iterator = buildings.begin(); iterator != buildings.end(); ++iterator)
+		{
+			value.buildings.push_back(building_snapshot{(*iterator)->get_x(), (*iterator)->get_y(), (*iterator)->get_type(), (*iterator)->get_width(), (*iterator)->get_height(), std::hash<building*>{}(*iterator)});
+		}
+	}
+
+	/**
+	 * Gets the map of the simulation.
+	 * @return The map.
+	 */
+	map* simulation::get_map()
+	{
+		return simulation_map.get();
+	}
+
+	/**
+	 * Gets the villager AI of the simulation.
+	 * @return The villager AI.
+	 */
+	ai_manager* simulation::get_ai()
+	{
+		return simulation_ai.get();
+	}
+
+	/**
+	 * Gets the job system of the simulation.
+	 * @return The job system.
+	 */
+	job_system* simulation::get_jobs()
+	{
+		return &jobs;
+	}
+
+	/**
+	 * Gets the villager needs batch of the simulation.
+	 * @return The needs batch.
+	 */
+	needs_batch* simulation::get_needs()
+	{
+		return &needs;
+	}
+
+	/**
+	 * Updates the entities within the simulation.
+	 * Handles time-based state changes.
+	 */
+	void simulation::update()
+	{
+		slot_view<villager> villagers = simulation_map->get_villagers();
+		bool update_villager_health = false, update_villager_health_regen = false, update_villager_needs = false;
+
+		if(timers.time > timers.villager_health + 1000)
+		{
+			timers.villager_health = timers.time;
+			update_villager_health = true;
+		}
+
+		if(timers.time > timers.villager_health_regen + 30000)
+		{
+			timers.villager_health_regen = timers.time;
+			update_villager_health_regen = true;
+		}
+
+		if(timers.time > timers.villager_needs + 15000)
+		{
+			timers.villager_needs = timers.time;
+			update_villager_needs = true;
+		}
+
+		// Only the resources that have changed since the last update, or are due to regrow, need updating
+		std::vector<handle> resources = simulation_map->take_changed_resources();
+
+		while(!regrowth.empty() && regrowth.top().time < timers.time)
+		{
+			resources.push_back(regrowth.top().target);
+			regrowth.pop();
+		}
+
+		// Update each resource once
+		std::sort(resources.begin(), resources.end(), [](handle a, handle b) { return a.index < b.index || (a.index == b.index && a.generation < b.generation); });
+		resources.erase(std::unique(resources.begin(), resources.end()), resources.end());
+		job_counter resources_updated;
+
+		// Update the resources on the job system while the villagers are updated on this thread
+		// Each resource only changes itself, so the result does not depend on the order the jobs run in
+		for(std::size_t first = 0; first < resources.size(); first += RESOURCE_GRAIN)
+		{
+			jobs.run(jobtype::resource_update, [this, &resources, first]()
+			{
+				for(std::size_t i = first; i < first + RESOURCE_GRAIN && i < resources.size(); ++i)
+				{
+					resource* value = simulation_map->get_resource(resources[i]);
+
+					if(value != nullptr)
+					{
+						update_resource(value);
+					}
+				}
+			}, &resources_updated);
+		}
+
+		needs.clear();
+
+		// Loop through each villager in the vector
+		for(slot_view<villager>::iterator iterator = villagers.begin(); iterator != villagers.end(); ++iterator)
+		{
+			// If the villager loses all health, create a grave resource containing all of its items
+			if((*iterator)->get_health() <= 0)
+			{
+				resource* target = new resource((*iterator)->get_x(), (*iterator)->get_y(), resourcetype::grave);
+				inventory* villager_inv = (*iterator)->get_inventory();
+
+				while(villager_inv->get_item_count() > 0)
+				{
+					std::unique_ptr<item> target_item = villager_inv->take_item(villager_inv->get_items()[0]);
+
+					if(target_item.get() != nullptr)
+					{
+						target->get_inventory()->add_item(std::move(target_item));
+						target->set_harvestable(true);
+					}
+				}
+
+				simulation_map->get_commands()->remove_villager(*iterator);
+				simulation_map->get_commands()->add_resource(target);
+			}
+			else
+			{
+				needs.add_villager(*iterator);
+			}
+		}
+
+		// Clamp health to 100 and needs to 0, then reduce villager health by 1 every second if fatigue, hunger or thirst is above 100,
+		// increase villager health by 1 every 30 seconds and increase villager fatigue, hunger and thirst by 1 every 15 seconds
+		needs.update(update_villager_health, update_villager_health_regen, update_villager_needs);
+		needs.store();
+
+		jobs.wait(&resources_updated);
+
+		// Schedule the resources that are waiting to regrow
+		for(std::vector<handle>::const_iterator iterator = resources.begin(); iterator != resources.end(); ++iterator)
+		{
+			resource* value = simulation_map->get_resource(*iterator);
+
+			if(value != nullptr && value->get_harvestable() == false && value->get_harvestable_time() != 0)
+			{
+				regrowth.push(regrowth_event{value->get_harvestable_time(), *iterator});
+			}
+		}
+	}
+
+	/**
+	 * Updates the harvestable state and items of the resource.
+	 * Resources on unpathable terrain are already disabled by the map, so only regrowth and depletion are handled.
+	 * Updating a resource that has not changed and is not due to regrow has no effect.
+	 * May run concurrently with other resources, so only the resource is changed.
+	 * @param value - The resource.
+	 */
+	void simulation::update_resource(resource* value)
+	{
+		// Once the time has passed the resource timeout duration, set it as harvestable
+		// Also resets the inventory with a new set of items (excluding graves)
+		if(value->get_harvestable() == false && timers.time > value->get_harvestable_time() && value->get_harvestable_time() != 0)
+		{
+			value->set_harvestable(true);
+
+			// Scale down random number while preserving uniform distribution
+			random_stream stream(seed, ticks, value->get_handle(), randompurpose::resource_regrowth);
+			std::uniform_int_distribution<int> distribution(1, 5);
+			int quantity = distribution(stream);
+
+			switch(value->get_type())
+			{
+				case resourcetype::water :
+					for(int i = 0; i < quantity; ++i)
+					{
+						value->get_inventory()->add_item(new item(itemtype::water));
+					}
+					break;
+
+				case resourcetype::food :
+					for(int i = 0; i < quantity; ++i)
+					{
+						value->get_inventory()->add_item(new item(itemtype::food));
+					}
+					break;
+
+				case resourcetype::tree :
+					for(int i = 0; i < quantity; ++i)
+					{
+						value->get_inventory()->add_item(new item(itemtype::lumber));
+					}
+					break;
+
+				case resourcetype::stone :
+					for(int i = 0; i < quantity; ++i)
+					{
+						value->get_inventory()->add_item(new item(itemtype::stone));
+					}
+					break;
+
+				case resourcetype::ore :
+					for(int i = 0; i < quantity; ++i)
+					{
+						value->get_inventory()->add_item(new item(itemtype::stone));
+						value->get_inventory()->add_item(new item(itemtype::ore));
+					}
+					break;
+
+				default :
+					break;
+			}
+		}
+
+		// If all items have been harvested from the resource, set its harvestable state to false
+		if(value->get_inventory()->get_item_count() == 0 && value->get_harvestable() == true)
+		{
+			value->set_harvestable(false);
+
+			if(value->get_type() == resourcetype::grave)
+			{
+				value->set_harvestable_time(0);
+			}
+			else
+			{
+				value->set_harvestable_time(timers.time + 120000);
+			}
+		}
+	}
+
+	/**
+	 * Adds the bytes of the value to an FNV-1a hash.
+	 * @param hash - The hash to update.
+	 * @param value - The value to add.
+	 * @param size - The size of the value in bytes.
+	 */
+	void simulation::hash_bytes(std::uint64_t& hash, const void* value, std::size_t size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(value);
+
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			hash = (hash ^ bytes[i]) * 1099511628211ULL;
+		}
+	}
+}
@@ -0,0 +1,224 @@
+#include "simulation_runner.hpp"
+
+namespace villa
+{
+	const int simulation_runner::FAST_FORWARD_BUDGET;
+
+	/**
+	 * Constructor for the Simulation Runner class.
+	 * Creates the simulation and publishes its first snapshot. The simulation does not run until the runner is started.
+	 * @param seed - The seed of the simulation.
+	 * @param threads - The number of threads to run villager decisions on.
+	 */
+	simulation_runner::simulation_runner(unsigned int seed, unsigned int threads) : simulation_state(new simulation(seed, threads)), accumulator(0), timescale(1.0), fast_forward(false), stopping(false)
+	{
+		publish();
+		update_snapshot();
+	}
+
+	/**
+	 * Destructor for the Simulation Runner class.
+	 * Stops the simulation thread.
+	 */
+	simulation_runner::~simulation_runner()
+	{
+		stop();
+	}
+
+	/**
+	 * Starts running the simulation on its own thread.
+	 */
+	void simulation_runner::start()
+	{
+		if(!worker.joinable())
+		{
+			stopping = false;
+			worker = std::thread(&simulation_runner::work, this);
+		}
+	}
+
+	/**
+	 * Stops running the simulation, waiting for the current tick to finish.
+	 * Commands that have not run yet are kept until the runner is started again.
+	 */
+	void simulation_runner::stop()
+	{
+		if(worker.joinable())
+		{
+			stopping = true;
+			worker.join();
+		}
+	}
+
+	/**
+	 * Sets the number of simulated milliseconds run per wall-clock millisecond.
+	 * @param value - The timescale (0 pauses the simulation).
+	 */
+	void simulation_runner::set_timescale(double value)
+	{
+		timescale = value;
+	}
+
+	/**
+	 * Sets whether ticks are run as fast as possible, regardless of the timescale.
+	 * Normal speed resumes from the current time, without catching up.
+	 * @param value - Boolean representing whether to fast-forward.
+	 */
+	void simulation_runner::set_fast_forward(bool value)
+	{
+		fast_forward = value;
+	}
+
+	/**
+	 * Queues a command to run on the simulation thread before the next tick.
+	 * Commands run in the order they were queued, and may change the simulation.
+	 * @param command - The function to run, taking the simulation.
+	 */
+	void simulation_runner::run(std::function<void(simulation*)> command)
+	{
+		std::lock_guard<std::mutex> guard(command_lock);
+		commands.push_back(std::move(command));
+	}
+
+	/**
+	 * Takes the newest published snapshot, if one has been published since the last update.
+	 * Must only be called by the displaying thread.
+	 * @return Boolean representing whether the snapshot changed.
+	 */
+	bool simulation_runner::update_snapshot()
+	{
+		return snapshots.update();
+	}
+
+	/**
+	 * Gets the snapshot taken by the last update, which does not change until the next update.
+	 * Must only be called by the displaying thread.
+	 * @return The snapshot.
+	 */
+	simulation_snapshot* simulation_runner::get_snapshot()
+	{
+		return &snapshots.get_front();
+	}
+
+	/**
+	 * Gets the simulation. Must not be used while the runner is started (use commands instead).
+	 * @return The simulation.
+	 */
+	simulation* simulation_runner::get_simulation()
+	{
+		return simulation_state.get();
+	}
+
+	/**
+	 * Runs ticks on the simulation thread until the runner is stopped.
+	 * Ticks are run as simulated time accumulates, and the thread sleeps until the next tick is due.
+	 * While fast-forwarding, ticks are run back to back and a snapshot is published once per batch.
+	 * If the simulation falls too far behind, the remaining time is dropped rather than catching up.
+	 */
+	void simulation_runner::work()
+	{
+		const int UPDATE_TIME = simulation::UPDATE_TIME;
+		std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+		accumulator = 0;
+
+		while(!stopping)
+		{
+			run_commands();
+
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			double elapsed = std::chrono::duration<double, std::milli>(now - last).count();
+			last = now;
+
+			if(simulation_state->get_finished())
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(UPDATE_TIME));
+			}
+			else if(fast_forward)
+			{
+				// Run ticks for a frame's worth of time before publishing, so that snapshots are not taken every tick
+				std::chrono::steady_clock::time_point deadline = now + std::chrono::milliseconds(FAST_FORWARD_BUDGET);
+				accumulator = 0;
+
+				do
+				{
+					simulation_state->tick();
+				}
+				while(fast_forward && !stopping && !simulation_state->get_finished() && std::chrono::steady_clock::now() < deadline);
+
+				publish();
+			}
+			else
+			{
+				int ticks = 0;
+				accumulator += elapsed * timescale;
+
+				while(accumulator >= UPDATE_TIME && ticks < MAX_TICKS_BEHIND && !simulation_state->get_finished())
+				{
+					simulation_state->tick();
+					accumulator -= UPDATE_TIME;
+					ticks += 1;
+				}
+
+				if(ticks == MAX_TICKS_BEHIND)
+				{
+					accumulator = 0;
+				}
+
+				if(ticks > 0)
+				{
+					publish();
+				}
+				else
+				{
+					// Sleep until the next tick is due, waking at least once per tick for commands and speed changes
+					double remaining = timescale > 0 ? (UPDATE_TIME - accumulator) / timescale : UPDATE_TIME;
+					std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(std::min(remaining, (double)UPDATE_TIME)));
+				}
+			}
+		}
+	}
+
+	/**
+	 * Runs the queued commands on the simulation thread.
+	 * A snapshot is published afterwards, so that their changes are displayed even while the simulation is paused.
+	 */
+	void simulation_runner::run_commands()
+	{
+		std::vector<std::function<void(simulation*)>> pending;
+
+		{
+			std::lock_guard<std::mutex> guard(command_lock);
+			pending.swap(commands);
+		}
+
+		// Objects created by the commands belong to the map
+		simulation_state->get_map()->use_allocator();
+
+		for(std::vector<std::function<void(simulation*)>>::iterator iterator = pending.begin(); iterator != pending.end(); ++iterator)
+		{
+			(*iterator)(simulation_state.get());
+		}
+
+		if(!pending.empty())
+		{
+			publish();
+		}
+	}
+
+	/**
+	 * Takes a snapshot of the simulation into the back slot and publishes it.
+	 * The snapshot records the time not yet covered by a tick, so that movement can be displayed between ticks.
+	 * While fast-forwarding, ticks are not paced, so the snapshot is displayed as of its last tick.
+	 */
+	void simulation_runner::publish()
+	{
+		simulation_snapshot& value = snapshots.get_back();
+		simulation_state->take_snapshot(value);
+
+		value.accumulator = fast_forward ? static_cast<double>(simulation::UPDATE_TIME) : accumulator;
+		value.timescale = fast_forward ? 0 : timescale.load();
+		value.published = std::chrono::steady_clock::now();
+
+		snapshots.publish();
+	}
+}
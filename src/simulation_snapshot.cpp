@@ -0,0 +1,84 @@
+#include "simulation_snapshot.hpp"
+#include <algorithm>
+#include <cmath>
+#include "simulation.hpp"
+
+namespace villa
+{
+	/**
+	 * Checks whether the villager is at the target coordinates, matching entity::is_at.
+	 * @param x - The x-coord of the target.
+	 * @param y - The y-coord of the target.
+	 * @return Boolean representing whether the villager is at the target.
+	 */
+	bool villager_snapshot::is_at(double x, double y) const
+	{
+		// If the villager is within 8 pixels (1/2 tile) of the target, return true
+		return std::abs(this->x - x) <= 8 && std::abs(this->y - y) <= 8;
+	}
+
+	/**
+	 * Gets the x-coord of the villager between the last two ticks.
+	 * @param alpha - The fraction of the last tick to display (0 for the position before the tick, 1 for the position after it).
+	 * @return The interpolated x-coord of the villager.
+	 */
+	double villager_snapshot::get_x(double alpha) const
+	{
+		return this->previous_x + (this->x - this->previous_x) * alpha;
+	}
+
+	/**
+	 * Gets the y-coord of the villager between the last two ticks.
+	 * @param alpha - The fraction of the last tick to display (0 for the position before the tick, 1 for the position after it).
+	 * @return The interpolated y-coord of the villager.
+	 */
+	double villager_snapshot::get_y(double alpha) const
+	{
+		return this->previous_y + (this->y - this->previous_y) * alpha;
+	}
+
+	/**
+	 * Checks whether the resource is at the target coordinates, matching entity::is_at.
+	 * @param x - The x-coord of the target.
+	 * @param y - The y-coord of the target.
+	 * @return Boolean representing whether the resource is at the target.
+	 */
+	bool resource_snapshot::is_at(double x, double y) const
+	{
+		// If the resource is within 8 pixels (1/2 tile) of the target, return true
+		return std::abs(this->x - x) <= 8 && std::abs(this->y - y) <= 8;
+	}
+
+	/**
+	 * Checks whether the building is at the target coordinates, matching building::is_at.
+	 * @param x - The x-coord of the target.
+	 * @param y - The y-coord of the target.
+	 * @return Boolean representing whether the building is at the target.
+	 */
+	bool building_snapshot::is_at(double x, double y) const
+	{
+		// If the target is within 8 pixels (1/2 tile) of the building, return true
+		return x >= this->x - 8 && x <= (this->x + (this->width * 16) + 8) && y >= (this->y - (this->height * 16) - 8) && y <= this->y + 8;
+	}
+
+	/**
+	 * Constructor for the Simulation Snapshot struct.
+	 * The snapshot is empty, and its terrain version matches no map so that the tiles are copied by the first capture.
+	 */
+	simulation_snapshot::simulation_snapshot() : ticks(0), time(0), accumulator(0), timescale(0), published(), finished(false), resource_counts(), terrain_version(static_cast<unsigned long>(-1)), tiles(), resource_rows() { }
+
+	/**
+	 * Gets the fraction of the last tick to display, so that movement appears smooth between ticks.
+	 * The displayed state trails the simulation by up to a tick: the simulated time that has accumulated since the
+	 * last tick (when published, plus the time since then at the published timescale) selects a point between the
+	 * positions before and after the last tick.
+	 * @param now - The current time.
+	 * @return The fraction of the last tick, from 0 to 1.
+	 */
+	double simulation_snapshot::get_alpha(std::chrono::steady_clock::time_point now) const
+	{
+		double elapsed = std::max(std::chrono::duration<double, std::milli>(now - published).count(), 0.0);
+
+		return std::min(std::max((accumulator + elapsed * timescale) / simulation::UPDATE_TIME, 0.0), 1.0);
+	}
+}
@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+#include "arena.hpp"
+#include "job_system.hpp"
+#include "map.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Arena reuses freed blocks of the same size
+ */
+TEST(ArenaTest, ReuseFreedBlock)
+{
+	arena target;
+	void* first = arena::allocate(&target, 40);
+	arena::deallocate(first);
+	void* second = arena::allocate(&target, 40);
+
+	// The freed block should be handed out again instead of reserving more space
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(2u, target.get_stats().allocations);
+	EXPECT_EQ(1u, target.get_stats().reused);
+	EXPECT_EQ(1u, target.get_stats().live);
+	EXPECT_EQ(1u, target.get_stats().chunks);
+
+	arena::deallocate(second);
+}
+
+/**
+ * Tests whether the Arena allocates aligned blocks from a new chunk once the current one is full
+ */
+TEST(ArenaTest, NewChunk)
+{
+	arena target(256);
+
+	for(int i = 0; i < 8; ++i)
+	{
+		void* value = arena::allocate(&target, 48);
+
+		EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(value) % 16);
+	}
+
+	EXPECT_EQ(2u, target.get_stats().chunks);
+	EXPECT_EQ(8u, target.get_stats().live);
+}
+
+/**
+ * Tests whether objects created while a map exists are allocated from its arena
+ */
+TEST(ArenaTest, MapAllocation)
+{
+	std::mt19937 rng(0);
+	std::unique_ptr<map> target(new map(rng));
+
+	// The map's tiles should have been allocated from its arena
+	std::size_t live = target->get_allocation_stats().live;
+	EXPECT_GE(live, 2500u);
+
+	task* value = new task(tasktype::idle, taskdata(std::make_pair(0, 0)));
+	EXPECT_EQ(live + 1, target->get_allocation_stats().live);
+
+	delete value;
+	EXPECT_EQ(live, target->get_allocation_stats().live);
+
+	// Once the map is destroyed, objects should be allocated from the heap
+	target.reset();
+	EXPECT_EQ(nullptr, arena::get_current());
+}
+
+/**
+ * Tests whether each thread has its own current Arena
+ */
+TEST(ArenaTest, ThreadCurrent)
+{
+	arena target;
+	arena::set_current(&target);
+
+	// Another thread should not allocate from this thread's arena
+	arena* other = &target;
+	std::thread([&other]() { other = arena::get_current(); }).join();
+	EXPECT_EQ(nullptr, other);
+
+	// Jobs should allocate from the arena of the thread that runs the loop
+	job_system jobs(4);
+	std::vector<arena_allocated*> values(256, nullptr);
+
+	jobs.parallel_for(jobtype::general, values.size(), 8, [&values](std::size_t index)
+	{
+		values[index] = new arena_allocated();
+	});
+
+	EXPECT_EQ(256u, target.get_stats().live);
+
+	for(std::vector<arena_allocated*>::iterator iterator = values.begin(); iterator != values.end(); ++iterator)
+	{
+		delete *iterator;
+	}
+
+	EXPECT_EQ(0u, target.get_stats().live);
+
+	arena::set_current(nullptr);
+}
+
+/**
+ * Tests whether blocks cached by a thread are returned to the Arena when the thread exits, and freed on other threads
+ */
+TEST(ArenaTest, ThreadCache)
+{
+	arena target;
+	std::vector<void*> values;
+
+	std::thread([&target, &values]()
+	{
+		for(int i = 0; i < 100; ++i)
+		{
+			values.push_back(arena::allocate(&target, 40));
+		}
+
+		arena::deallocate(arena::allocate(&target, 40));
+	}).join();
+
+	EXPECT_EQ(101u, target.get_stats().allocations);
+	EXPECT_EQ(100u, target.get_stats().live);
+
+	for(std::vector<void*>::iterator iterator = values.begin(); iterator != values.end(); ++iterator)
+	{
+		arena::deallocate(*iterator);
+	}
+
+	EXPECT_EQ(0u, target.get_stats().live);
+
+	// The blocks freed by both threads should be reused rather than reserving more space
+	std::size_t used = target.get_stats().used;
+	void* value = arena::allocate(&target, 40);
+
+	EXPECT_EQ(1u, target.get_stats().reused);
+	EXPECT_EQ(used, target.get_stats().used);
+	EXPECT_EQ(1u, target.get_stats().live);
+
+	arena::deallocate(value);
+}
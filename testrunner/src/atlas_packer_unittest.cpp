@@ -0,0 +1,65 @@
+#include "gtest/gtest.h"
+#include "atlas_packer.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Atlas Packer fills a shelf from left to right before starting a new shelf
+ */
+TEST(AtlasPackerTest, Shelves)
+{
+	atlas_packer target(64, 64, 0);
+	int x = -1, y = -1;
+
+	ASSERT_TRUE(target.insert(32, 16, x, y));
+	EXPECT_EQ(0, x);
+	EXPECT_EQ(0, y);
+
+	ASSERT_TRUE(target.insert(32, 16, x, y));
+	EXPECT_EQ(32, x);
+	EXPECT_EQ(0, y);
+
+	// The first shelf is full, so the rectangle starts a new shelf
+	ASSERT_TRUE(target.insert(16, 16, x, y));
+	EXPECT_EQ(0, x);
+	EXPECT_EQ(16, y);
+
+	// Shorter rectangles fit on an existing shelf
+	ASSERT_TRUE(target.insert(16, 8, x, y));
+	EXPECT_EQ(16, x);
+	EXPECT_EQ(16, y);
+	EXPECT_EQ(32, target.get_used_height());
+}
+
+/**
+ * Tests whether the Atlas Packer never places overlapping rectangles, and rejects rectangles once the page is full
+ */
+TEST(AtlasPackerTest, NoOverlap)
+{
+	atlas_packer target(100, 100, 1);
+	std::vector<std::vector<int>> placed;
+	int x, y;
+
+	for(int i = 0; i < 200; ++i)
+	{
+		int width = 4 + i % 13, height = 12 - i % 9;
+
+		if(target.insert(width, height, x, y))
+		{
+			EXPECT_LE(x + width, 100);
+			EXPECT_LE(y + height, 100);
+
+			for(std::vector<std::vector<int>>::const_iterator iterator = placed.begin(); iterator != placed.end(); ++iterator)
+			{
+				bool separate = x >= (*iterator)[0] + (*iterator)[2] || (*iterator)[0] >= x + width || y >= (*iterator)[1] + (*iterator)[3] || (*iterator)[1] >= y + height;
+				EXPECT_TRUE(separate);
+			}
+
+			placed.push_back(std::vector<int>{x, y, width, height});
+		}
+	}
+
+	EXPECT_FALSE(placed.empty());
+	EXPECT_LT(placed.size(), 200u);
+	EXPECT_FALSE(target.insert(101, 1, x, y));
+}
@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "camera.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Camera keeps the world point under the cursor in place when zooming
+ */
+TEST(CameraTest, ZoomAt)
+{
+	camera target(800, 800, 800, 800);
+
+	EXPECT_EQ(1.0, target.get_zoom());
+	EXPECT_EQ(400, target.to_screen_x(400));
+
+	target.zoom_at(2.0, 200, 600);
+
+	EXPECT_EQ(2.0, target.get_zoom());
+	EXPECT_EQ(200, target.to_screen_x(200));
+	EXPECT_EQ(600, target.to_screen_y(600));
+	EXPECT_DOUBLE_EQ(200.0, target.to_world_x(200));
+
+	// The zoom is limited to the range between the whole world and the maximum zoom
+	target.zoom_at(100.0, 0, 0);
+	EXPECT_EQ(camera::MAX_ZOOM, target.get_zoom());
+
+	target.zoom_at(0.01, 0, 0);
+	EXPECT_EQ(1.0, target.get_zoom());
+	EXPECT_EQ(0.0, target.get_x());
+	EXPECT_EQ(0.0, target.get_y());
+}
+
+/**
+ * Tests whether the Camera keeps the view within the world when panning, and culls rectangles outside the view
+ */
+TEST(CameraTest, PanAndCull)
+{
+	camera target(800, 800, 800, 800);
+	target.zoom_at(2.0, 0, 0);
+
+	// At twice the zoom, the view covers 400x400 pixels of the world
+	target.pan(2000, 100);
+
+	EXPECT_EQ(400.0, target.get_x());
+	EXPECT_EQ(50.0, target.get_y());
+
+	EXPECT_TRUE(target.is_visible(400, 50, 16, 16));
+	EXPECT_TRUE(target.is_visible(390, 40, 16, 16));
+	EXPECT_FALSE(target.is_visible(384, 50, 16, 16));
+	EXPECT_FALSE(target.is_visible(500, 450, 16, 16));
+
+	target.pan(-10000, -10000);
+
+	EXPECT_EQ(0.0, target.get_x());
+	EXPECT_EQ(0.0, target.get_y());
+}
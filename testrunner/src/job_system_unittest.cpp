@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "job_system.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Job System runs each iteration of a loop exactly once
+ */
+TEST(JobSystemTest, ParallelFor)
+{
+	job_system target(4);
+	std::vector<int> counts(1000, 0);
+
+	EXPECT_EQ(4u, target.get_thread_count());
+
+	// Run the loop several times, with different grain sizes, to reuse the workers
+	for(int i = 0; i < 10; ++i)
+	{
+		target.parallel_for(jobtype::general, counts.size(), i + 1, [&](std::size_t index)
+		{
+			counts[index] += 1;
+		});
+	}
+
+	for(std::vector<int>::const_iterator iterator = counts.begin(); iterator != counts.end(); ++iterator)
+	{
+		EXPECT_EQ(10, *iterator);
+	}
+}
+
+/**
+ * Tests whether the Job System runs a loop of a single grain on the calling thread
+ */
+TEST(JobSystemTest, SingleGrainInline)
+{
+	job_system target(4);
+	std::thread::id caller = std::this_thread::get_id();
+	int inline_count = 0;
+
+	target.parallel_for(jobtype::villager_decision, 8, 8, [&](std::size_t)
+	{
+		inline_count += std::this_thread::get_id() == caller ? 1 : 0;
+	});
+
+	EXPECT_EQ(8, inline_count);
+	EXPECT_EQ(1u, target.get_stats(jobtype::villager_decision).jobs);
+}
+
+/**
+ * Tests whether the Job System only starts a job once the jobs it depends on have finished
+ */
+TEST(JobSystemTest, Dependency)
+{
+	job_system target(4);
+	job_counter first, second;
+	std::atomic<int> finished(0);
+	int seen = -1;
+
+	for(int i = 0; i < 100; ++i)
+	{
+		target.run(jobtype::general, [&]()
+		{
+			finished += 1;
+		}, &first);
+	}
+
+	target.run(jobtype::general, [&]()
+	{
+		seen = finished;
+	}, &second, &first);
+
+	target.wait(&second);
+
+	EXPECT_TRUE(first.get_finished());
+	EXPECT_EQ(100, seen);
+}
+
+/**
+ * Tests whether the Job System runs jobs inline and records their statistics with a single thread
+ */
+TEST(JobSystemTest, SingleThreadStats)
+{
+	job_system target(1);
+	int sum = 0;
+
+	target.parallel_for(jobtype::resource_update, 100, 10, [&](std::size_t index)
+	{
+		sum += index;
+	});
+
+	EXPECT_EQ(4950, sum);
+	EXPECT_EQ(10u, target.get_stats(jobtype::resource_update).jobs);
+	EXPECT_EQ(0u, target.get_stats(jobtype::villager_decision).jobs);
+
+	target.reset_stats();
+
+	EXPECT_EQ(0u, target.get_stats(jobtype::resource_update).jobs);
+}
@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include <random>
+#include "map.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Map indexes resources by the tile they are on
+ */
+TEST(MapTest, ResourcesAt)
+{
+	std::mt19937 rng(0);
+	std::unique_ptr<map> target(new map(rng));
+	std::size_t count = target->get_resources_at(20, 20).size();
+	resource* value = new resource(20 * 16 + 8, 20 * 16 + 8, resourcetype::tree);
+
+	target->add_resource(value);
+
+	std::vector<resource*> resources = target->get_resources_at(20, 20);
+	ASSERT_EQ(count + 1, resources.size());
+	EXPECT_EQ(value, resources.back());
+
+	target->remove_resource(value);
+
+	EXPECT_EQ(count, target->get_resources_at(20, 20).size());
+	EXPECT_TRUE(target->get_resources_at(-1, 50).empty());
+}
+
+/**
+ * Tests whether the Map disables the resources under a new building, and only those resources
+ */
+TEST(MapTest, BuildingDisablesResources)
+{
+	std::mt19937 rng(0);
+	std::unique_ptr<map> target(new map(rng));
+	int x = 0, y = 0;
+
+	// Find a space for a small building
+	for(int i = 33; i < 767 && x == 0; i += 16)
+	{
+		for(int j = 33; j < 767 && x == 0; j += 16)
+		{
+			if(target->get_available_space(i, j, buildingtype::house_small) && target->get_available_space(i + 32, j, buildingtype::house_small))
+			{
+				x = i;
+				y = j;
+			}
+		}
+	}
+
+	ASSERT_NE(0, x);
+
+	resource* covered = new resource(x, y, resourcetype::tree);
+	resource* uncovered = new resource(x + 48, y, resourcetype::tree);
+	target->add_resource(covered);
+	target->add_resource(uncovered);
+	covered->set_harvestable(true);
+	uncovered->set_harvestable(true);
+
+	ASSERT_TRUE(target->add_building(new building(x, y, buildingtype::house_small)));
+
+	EXPECT_FALSE(covered->get_harvestable());
+	EXPECT_EQ(0u, covered->get_harvestable_time());
+	EXPECT_TRUE(uncovered->get_harvestable());
+
+	// Resources added on unpathable terrain are disabled straight away
+	resource* grave = new resource(x, y, resourcetype::grave);
+	grave->set_harvestable(true);
+	target->add_resource(grave);
+
+	EXPECT_FALSE(grave->get_harvestable());
+	EXPECT_EQ(0u, grave->get_harvestable_time());
+}
+
+/**
+ * Tests whether the Map updates the variants of a changed tile and its neighbours
+ */
+TEST(MapTest, TileVariants)
+{
+	std::mt19937 rng(0);
+	std::unique_ptr<map> target(new map(rng));
+	unsigned long version = target->get_terrain_version();
+
+	// The corner of the map is always water
+	EXPECT_EQ(tilevariant::centre, target->get_tile_at(0, 0)->get_variant());
+
+	target->set_tile_type(1, 1, tiletype::sand);
+
+	EXPECT_EQ(version + 1, target->get_terrain_version());
+	EXPECT_EQ(tilevariant::corner_south_east, target->get_tile_at(1, 1)->get_variant());
+	EXPECT_EQ(tilevariant::south, target->get_tile_at(1, 0)->get_variant());
+	EXPECT_EQ(tilevariant::east, target->get_tile_at(0, 1)->get_variant());
+	EXPECT_EQ(tilevariant::corner_south_west, target->get_tile_at(0, 0)->get_variant());
+
+	target->set_tile_type(1, 1, tiletype::water);
+
+	EXPECT_EQ(tilevariant::centre, target->get_tile_at(0, 0)->get_variant());
+	EXPECT_EQ(tilevariant::centre, target->get_tile_at(1, 1)->get_variant());
+}
+
+/**
+ * Tests whether the Map visits exactly the resources on the tiles within a rectangle
+ */
+TEST(MapTest, ResourcesInRectangle)
+{
+	std::mt19937 rng(0);
+	std::unique_ptr<map> target(new map(rng));
+	int expected = 0, visited = 0, total = 0;
+
+	target->for_each_resource([&](resource* value)
+	{
+		int x = value->get_x() / 16, y = value->get_y() / 16;
+		expected += x >= 10 && x <= 20 && y >= 5 && y <= 30 ? 1 : 0;
+	});
+
+	target->for_each_resource_in(10, 5, 20, 30, [&](resource* value)
+	{
+		int x = value->get_x() / 16, y = value->get_y() / 16;
+		EXPECT_TRUE(x >= 10 && x <= 20 && y >= 5 && y <= 30);
+		visited += 1;
+	});
+
+	EXPECT_EQ(expected, visited);
+
+	// Rectangles are clamped to the map
+	target->for_each_resource_in(-10, -10, 100, 100, [&](resource*)
+	{
+		total += 1;
+	});
+
+	EXPECT_EQ(static_cast<int>(target->get_resources().size()), total);
+}
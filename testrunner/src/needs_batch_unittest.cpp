@@ -0,0 +1,152 @@
+#include <random>
+#include "gtest/gtest.h"
+#include "needs_batch.hpp"
+
+using namespace villa;
+
+/**
+ * Applies the villager rules one villager at a time, as done before the rules were batched.
+ */
+static void update_reference(villager* target, bool update_health, bool update_health_regen, bool update_needs)
+{
+	if(target->get_health() <= 0)
+	{
+		return;
+	}
+
+	if(target->get_health() > 100)
+	{
+		target->set_health(100);
+	}
+
+	if(target->get_fatigue() < 0)
+	{
+		target->set_fatigue(0);
+	}
+
+	if(target->get_hunger() < 0)
+	{
+		target->set_hunger(0);
+	}
+
+	if(target->get_thirst() < 0)
+	{
+		target->set_thirst(0);
+	}
+
+	if(update_health == true)
+	{
+		if(target->get_fatigue() >= 100 || target->get_hunger() >= 100 || target->get_thirst() >= 100)
+		{
+			target->set_health(target->get_health() - 1);
+		}
+	}
+
+	if(update_health_regen == true)
+	{
+		target->set_health(target->get_health() + 1);
+	}
+
+	if(update_needs == true)
+	{
+		target->set_fatigue(target->get_fatigue() + 1);
+		target->set_hunger(target->get_hunger() + 1);
+		target->set_thirst(target->get_thirst() + 1);
+	}
+}
+
+/**
+ * Checks that the kernel produces the same stats as the reference rules for every flag combination.
+ */
+static void expect_kernel_matches_reference(needskernel kernel)
+{
+	std::mt19937 rng(1234);
+	std::uniform_int_distribution<int> distribution(-20, 130);
+
+	// Use a count that does not fill a whole number of registers to cover the remainder
+	for(int count = 0; count < 40; count += 13)
+	{
+		for(int flags = 0; flags < 8; ++flags)
+		{
+			std::vector<std::unique_ptr<villager>> expected, actual;
+			needs_batch batch;
+			batch.set_kernel(kernel);
+
+			for(int i = 0; i < count; ++i)
+			{
+				int health = distribution(rng), hunger = distribution(rng), thirst = distribution(rng), fatigue = distribution(rng);
+
+				expected.push_back(std::unique_ptr<villager>(new villager(0, 0)));
+				actual.push_back(std::unique_ptr<villager>(new villager(0, 0)));
+
+				for(villager* target : {expected.back().get(), actual.back().get()})
+				{
+					target->set_health(health);
+					target->set_hunger(hunger);
+					target->set_thirst(thirst);
+					target->set_fatigue(fatigue);
+				}
+
+				update_reference(expected.back().get(), flags & 1, flags & 2, flags & 4);
+				batch.add_villager(actual.back().get());
+			}
+
+			batch.update(flags & 1, flags & 2, flags & 4);
+			batch.store();
+
+			for(int i = 0; i < count; ++i)
+			{
+				EXPECT_EQ(expected[i]->get_health(), actual[i]->get_health());
+				EXPECT_EQ(expected[i]->get_hunger(), actual[i]->get_hunger());
+				EXPECT_EQ(expected[i]->get_thirst(), actual[i]->get_thirst());
+				EXPECT_EQ(expected[i]->get_fatigue(), actual[i]->get_fatigue());
+			}
+		}
+	}
+}
+
+/**
+ * Tests whether the scalar kernel matches the reference rules
+ */
+TEST(NeedsBatchTest, ScalarMatchesReference)
+{
+	expect_kernel_matches_reference(needskernel::scalar);
+}
+
+/**
+ * Tests whether the SSE2 kernel matches the reference rules
+ */
+TEST(NeedsBatchTest, SSE2MatchesReference)
+{
+	if(!needs_batch::get_kernel_supported(needskernel::sse2))
+	{
+		return;
+	}
+
+	expect_kernel_matches_reference(needskernel::sse2);
+}
+
+/**
+ * Tests whether the AVX2 kernel matches the reference rules
+ */
+TEST(NeedsBatchTest, AVX2MatchesReference)
+{
+	if(!needs_batch::get_kernel_supported(needskernel::avx2))
+	{
+		return;
+	}
+
+	expect_kernel_matches_reference(needskernel::avx2);
+}
+
+/**
+ * Tests whether the batch falls back to the scalar kernel when the kernel is unsupported
+ */
+TEST(NeedsBatchTest, SetKernelUnsupported)
+{
+	needs_batch batch;
+	batch.set_kernel(needskernel::avx2);
+
+	// The batch should only use the AVX2 kernel if the CPU supports it
+	EXPECT_EQ(needs_batch::get_kernel_supported(needskernel::avx2) ? needskernel::avx2 : needskernel::scalar, batch.get_kernel());
+}
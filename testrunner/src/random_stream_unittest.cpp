@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+#include <random>
+#include "random_stream.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Random Stream matches the Philox4x32-10 known answers
+ */
+TEST(RandomStreamTest, KnownAnswer)
+{
+	const std::uint32_t zero_counter[4] = {0, 0, 0, 0}, zero_key[2] = {0, 0};
+	const std::uint32_t full_counter[4] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}, full_key[2] = {0xFFFFFFFF, 0xFFFFFFFF};
+	std::uint32_t result[4];
+
+	random_stream::philox(zero_counter, zero_key, result);
+	EXPECT_EQ(0x6627E8D5u, result[0]);
+	EXPECT_EQ(0xE169C58Du, result[1]);
+	EXPECT_EQ(0xBC57AC4Cu, result[2]);
+	EXPECT_EQ(0x9B00DBD8u, result[3]);
+
+	random_stream::philox(full_counter, full_key, result);
+	EXPECT_EQ(0x408F276Du, result[0]);
+	EXPECT_EQ(0x41C83B0Eu, result[1]);
+	EXPECT_EQ(0xA20BC7C6u, result[2]);
+	EXPECT_EQ(0x6D5451FDu, result[3]);
+}
+
+/**
+ * Tests whether Random Streams with the same key produce the same numbers regardless of other streams
+ */
+TEST(RandomStreamTest, Independent)
+{
+	random_stream first(42, 100, handle{3, 1}, randompurpose::idle);
+	random_stream other(42, 100, handle{4, 1}, randompurpose::idle);
+	random_stream second(42, 100, handle{3, 1}, randompurpose::idle);
+
+	// Drawing from another stream should not affect the numbers drawn from the first
+	for(int i = 0; i < 5; ++i)
+	{
+		other();
+	}
+
+	bool different = false;
+
+	for(int i = 0; i < 10; ++i)
+	{
+		random_stream::result_type value = first();
+
+		EXPECT_EQ(value, second());
+		different = different || value != other();
+	}
+
+	EXPECT_TRUE(different);
+
+	// The stream should work with the standard distributions
+	std::uniform_int_distribution<int> distribution(1, 6);
+	int roll = distribution(first);
+
+	EXPECT_GE(roll, 1);
+	EXPECT_LE(roll, 6);
+}
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include <chrono>
+#include <thread>
+#include "simulation_runner.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Simulation Runner publishes the state of a new simulation before it is started
+ */
+TEST(SimulationRunnerTest, FirstSnapshot)
+{
+	simulation_runner target(7);
+	simulation_snapshot* snapshot = target.get_snapshot();
+
+	EXPECT_EQ(0u, snapshot->ticks);
+	EXPECT_FALSE(snapshot->finished);
+	EXPECT_EQ(target.get_simulation()->get_map()->get_villagers().size(), snapshot->villagers.size());
+	EXPECT_EQ(target.get_simulation()->get_map()->get_terrain_version(), snapshot->terrain_version);
+}
+
+/**
+ * Tests whether the Simulation Runner runs ticks and commands on its own thread
+ */
+TEST(SimulationRunnerTest, RunTicksAndCommands)
+{
+	simulation_runner target(7, 2);
+	unsigned long command_ticks = 0;
+	bool command_run = false;
+
+	target.set_fast_forward(true);
+	target.run([&](simulation* value)
+	{
+		command_ticks = value->get_ticks();
+		command_run = true;
+	});
+	target.start();
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	// Wait for the snapshots to show that ticks have been run
+	while(target.get_snapshot()->ticks < 10 && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+	{
+		target.update_snapshot();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	target.stop();
+
+	// The command should have run before the first tick
+	EXPECT_TRUE(command_run);
+	EXPECT_EQ(0u, command_ticks);
+	EXPECT_GE(target.get_snapshot()->ticks, 10u);
+	EXPECT_GE(target.get_simulation()->get_ticks(), target.get_snapshot()->ticks);
+}
+
+/**
+ * Tests whether the Simulation Runner does not run ticks while paused
+ */
+TEST(SimulationRunnerTest, Paused)
+{
+	simulation_runner target(7);
+
+	target.set_timescale(0);
+	target.start();
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	target.stop();
+
+	EXPECT_FALSE(target.update_snapshot());
+	EXPECT_EQ(0u, target.get_simulation()->get_ticks());
+}
+
+/**
+ * Tests whether a snapshot interpolates villagers between their positions before and after the last tick
+ */
+TEST(SimulationRunnerTest, Interpolation)
+{
+	simulation_snapshot target;
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	villager_snapshot value{20, 40, 10, 30, 0};
+
+	target.published = now;
+	target.accumulator = simulation::UPDATE_TIME / 4.0;
+	target.timescale = 1.0;
+
+	// The accumulated time when published selects a point within the last tick
+	EXPECT_DOUBLE_EQ(0.25, target.get_alpha(now));
+	EXPECT_DOUBLE_EQ(12.5, value.get_x(target.get_alpha(now)));
+	EXPECT_DOUBLE_EQ(32.5, value.get_y(target.get_alpha(now)));
+
+	// Time passing after publishing moves the point forward at the timescale, stopping at the last tick
+	target.timescale = 2.0;
+
+	EXPECT_DOUBLE_EQ(0.25 + 2.0 / simulation::UPDATE_TIME, target.get_alpha(now + std::chrono::milliseconds(1)));
+	EXPECT_DOUBLE_EQ(1.0, target.get_alpha(now + std::chrono::seconds(1)));
+	EXPECT_DOUBLE_EQ(20, value.get_x(1.0));
+
+	// A paused snapshot stays where it was published
+	target.timescale = 0;
+
+	EXPECT_DOUBLE_EQ(0.25, target.get_alpha(now + std::chrono::seconds(1)));
+}
@@ -0,0 +1,350 @@
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+#include "random_stream.hpp"
+#include "simulation.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Simulation advances time by a fixed step each tick
+ */
+TEST(SimulationTest, Tick)
+{
+	simulation target(0);
+
+	EXPECT_FALSE(target.get_finished());
+
+	for(int i = 0; i < 60; ++i)
+	{
+		target.tick();
+	}
+
+	EXPECT_EQ(60u, target.get_ticks());
+	EXPECT_EQ(60u * simulation::UPDATE_TIME, target.get_time());
+}
+
+/**
+ * Tests whether Simulations with the same seed produce the same state
+ */
+TEST(SimulationTest, Deterministic)
+{
+	simulation first(1234), second(1234), other(4321);
+
+	for(int i = 0; i < 600; ++i)
+	{
+		first.tick();
+		second.tick();
+		other.tick();
+	}
+
+	EXPECT_EQ(first.get_state_hash(), second.get_state_hash());
+	EXPECT_NE(first.get_state_hash(), other.get_state_hash());
+}
+
+/**
+ * Tests whether Simulations produce the same state regardless of the number of threads
+ */
+TEST(SimulationTest, ThreadsMatchSingleThreaded)
+{
+	simulation single(1234, 1), multiple(1234, 4);
+
+	for(int i = 0; i < 600; ++i)
+	{
+		single.tick();
+		multiple.tick();
+
+		ASSERT_EQ(single.get_state_hash(), multiple.get_state_hash());
+	}
+}
+
+/**
+ * Tests whether Simulations with enough villagers to split their decisions between threads
+ * produce the same state regardless of the number of threads
+ */
+TEST(SimulationTest, ThreadsMatchManyVillagers)
+{
+	simulation one(1234, 1), two(1234, 2), four(1234, 4), eight(1234, 8);
+	simulation* targets[] = { &one, &two, &four, &eight };
+
+	for(simulation* target : targets)
+	{
+		target->get_map()->use_allocator();
+		int added = 0;
+
+		// Place the villagers on every third tile that can be walked on
+		for(int y = 8; y < 800 && added < 200; y += 48)
+		{
+			for(int x = 8; x < 800 && added < 200; x += 48)
+			{
+				added += target->get_map()->add_villager(new villager(x, y)) ? 1 : 0;
+			}
+		}
+
+		ASSERT_EQ(200, added);
+		ASSERT_EQ(205u, target->get_map()->get_villagers().size());
+	}
+
+	for(int i = 0; i < 300; ++i)
+	{
+		for(simulation* target : targets)
+		{
+			target->tick();
+		}
+
+		ASSERT_EQ(one.get_state_hash(), two.get_state_hash());
+		ASSERT_EQ(one.get_state_hash(), four.get_state_hash());
+		ASSERT_EQ(one.get_state_hash(), eight.get_state_hash());
+	}
+}
+
+/**
+ * Tests whether a Simulation regrows a depleted resource once its timeout has passed
+ */
+TEST(SimulationTest, ResourceRegrowth)
+{
+	simulation target(1234);
+
+	// Resources become harvestable after the first tick
+	target.tick();
+	target.tick();
+
+	resource* value = nullptr;
+
+	target.get_map()->for_each_resource([&](resource* candidate)
+	{
+		if(value == nullptr && candidate->get_type() == resourcetype::tree && candidate->get_harvestable() == true)
+		{
+			value = candidate;
+		}
+	});
+
+	ASSERT_NE(nullptr, value);
+
+	// Take all items from the resource, as a villager would
+	while(value->get_inventory()->get_item_count() > 0)
+	{
+		value->get_inventory()->take_item(value->get_inventory()->get_items()[0]);
+	}
+
+	target.get_map()->mark_resource_changed(value);
+	target.tick();
+
+	EXPECT_FALSE(value->get_harvestable());
+	ASSERT_NE(0u, value->get_harvestable_time());
+
+	unsigned int harvestable_time = value->get_harvestable_time();
+
+	while(target.get_time() <= harvestable_time)
+	{
+		target.tick();
+		EXPECT_FALSE(value->get_harvestable());
+	}
+
+	target.tick();
+
+	EXPECT_TRUE(value->get_harvestable());
+}
+
+/**
+ * Tests whether resources on unpathable terrain are never harvestable, as when every resource was checked each tick
+ */
+TEST(SimulationTest, UnpathableResourcesDisabled)
+{
+	simulation target(4321);
+
+	for(int i = 0; i < 3000 && !target.get_finished(); ++i)
+	{
+		target.tick();
+
+		target.get_map()->for_each_resource([&](resource* value)
+		{
+			if(target.get_map()->get_tile_at(value->get_x() / 16, value->get_y() / 16)->get_pathable() == false)
+			{
+				ASSERT_FALSE(value->get_harvestable());
+				ASSERT_EQ(0u, value->get_harvestable_time());
+			}
+		});
+	}
+}
+
+/**
+ * Tests whether the scheduled resource updates match checking every resource each tick,
+ * including a resource whose regrowth is cancelled by a building placed over it
+ */
+TEST(SimulationTest, RegrowthMatchesPerTickScan)
+{
+	/**
+	 * Expected resource struct.
+	 * The state of a resource after a tick, as found by checking it directly.
+	 */
+	struct expected_resource
+	{
+		resource* target;
+		bool harvestable;
+		unsigned int harvestable_time;
+		int items;
+		bool regrown;
+	};
+
+	simulation target(1234);
+	map* target_map = target.get_map();
+	std::vector<villager*> villagers;
+	int x = 0, y = 0, regrown = 0;
+
+	// Without villagers, resources only change by regrowing and by the changes made here
+	target_map->for_each_villager([&](villager* value)
+	{
+		villagers.push_back(value);
+	});
+
+	for(std::vector<villager*>::iterator iterator = villagers.begin(); iterator != villagers.end(); ++iterator)
+	{
+		target_map->remove_villager(*iterator);
+	}
+
+	// Find a space for a small building, and add a resource there for the building to cover while it regrows
+	for(int i = 33; i < 767 && x == 0; i += 16)
+	{
+		for(int j = 33; j < 767 && x == 0; j += 16)
+		{
+			if(target_map->get_available_space(i, j, buildingtype::house_small))
+			{
+				x = i;
+				y = j;
+			}
+		}
+	}
+
+	ASSERT_NE(0, x);
+
+	resource* covered = new resource(x, y, resourcetype::tree);
+	target_map->add_resource(covered);
+
+	// Run past the regrowth timeout of the resources depleted first
+	for(int i = 0; i < 7600; ++i)
+	{
+		// Take all items from some of the resources, as villagers would
+		if(i == 10 || i == 2000)
+		{
+			int index = 0;
+
+			target_map->for_each_resource([&](resource* value)
+			{
+				if(value->get_harvestable() == true && (index++ % 3 == 0 || value == covered))
+				{
+					while(value->get_inventory()->get_item_count() > 0)
+					{
+						value->get_inventory()->take_item(value->get_inventory()->get_items()[0]);
+					}
+
+					target_map->mark_resource_changed(value);
+				}
+			});
+		}
+
+		// Place a building over the resource while it is waiting to regrow
+		if(i == 3000)
+		{
+			ASSERT_FALSE(covered->get_harvestable());
+			ASSERT_NE(0u, covered->get_harvestable_time());
+			ASSERT_TRUE(target_map->add_building(new building(x, y, buildingtype::house_small)));
+		}
+
+		// Update every resource directly, as each tick did before regrowth was scheduled
+		std::vector<expected_resource> expected;
+		unsigned int time = target.get_time();
+
+		target_map->for_each_resource([&](resource* value)
+		{
+			expected_resource state = {value, value->get_harvestable(), value->get_harvestable_time(), value->get_inventory()->get_item_count(), false};
+
+			if(state.harvestable == false && time > state.harvestable_time && state.harvestable_time != 0)
+			{
+				random_stream stream(target.get_seed(), target.get_ticks(), value->get_handle(), randompurpose::resource_regrowth);
+				std::uniform_int_distribution<int> distribution(1, 5);
+				int quantity = distribution(stream);
+
+				state.harvestable = true;
+				state.regrown = true;
+
+				if(value->get_type() == resourcetype::ore)
+				{
+					state.items += quantity * 2;
+				}
+				else if(value->get_type() != resourcetype::grave)
+				{
+					state.items += quantity;
+				}
+			}
+
+			if(state.items == 0 && state.harvestable == true)
+			{
+				state.harvestable = false;
+				state.harvestable_time = value->get_type() == resourcetype::grave ? 0 : time + 120000;
+			}
+
+			expected.push_back(state);
+		});
+
+		target.tick();
+
+		for(std::vector<expected_resource>::const_iterator iterator = expected.begin(); iterator != expected.end(); ++iterator)
+		{
+			ASSERT_EQ(iterator->harvestable, iterator->target->get_harvestable()) << "tick " << i;
+			ASSERT_EQ(iterator->harvestable_time, iterator->target->get_harvestable_time()) << "tick " << i;
+			ASSERT_EQ(iterator->items, iterator->target->get_inventory()->get_item_count()) << "tick " << i;
+
+			if(iterator->regrown == true && i > 10)
+			{
+				regrown += 1;
+			}
+		}
+	}
+
+	// Resources depleted after the first ticks should have regrown, but not the one under the building
+	EXPECT_GT(regrown, 0);
+	EXPECT_FALSE(covered->get_harvestable());
+	EXPECT_EQ(0u, covered->get_harvestable_time());
+}
+
+/**
+ * Tests whether a Simulation snapshot copies the displayed state, with the resources grouped by row of tiles
+ */
+TEST(SimulationTest, Snapshot)
+{
+	simulation target(7);
+	simulation_snapshot snapshot;
+
+	for(int i = 0; i < 60; ++i)
+	{
+		target.tick();
+	}
+
+	target.take_snapshot(snapshot);
+
+	EXPECT_EQ(60u, snapshot.ticks);
+	EXPECT_EQ(target.get_time(), snapshot.time);
+	EXPECT_EQ(target.get_map()->get_villagers().size(), snapshot.villagers.size());
+	EXPECT_EQ(target.get_map()->get_buildings().size(), snapshot.buildings.size());
+	EXPECT_EQ(target.get_map()->get_resources().size(), snapshot.resources.size());
+	EXPECT_EQ(target.get_map()->get_resource_count(resourcetype::tree), snapshot.resource_counts[static_cast<int>(resourcetype::tree)]);
+	EXPECT_EQ(target.get_map()->get_tile_at(10, 20)->get_variant(), snapshot.tiles[10][20].variant);
+
+	// Each resource should be within its row of tiles
+	EXPECT_EQ(0u, snapshot.resource_rows[0]);
+	EXPECT_EQ(snapshot.resources.size(), snapshot.resource_rows[50]);
+
+	for(int j = 0; j < 50; ++j)
+	{
+		for(std::size_t i = snapshot.resource_rows[j]; i < snapshot.resource_rows[j + 1]; ++i)
+		{
+			EXPECT_EQ(j, static_cast<int>(snapshot.resources[i].y) / 16);
+		}
+	}
+
+	// Taking another snapshot into the same storage should replace its contents
+	target.take_snapshot(snapshot);
+
+	EXPECT_EQ(target.get_map()->get_villagers().size(), snapshot.villagers.size());
+}
@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "slot_map.hpp"
+#include "villager.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Slot Map can get an inserted value from its handle
+ */
+TEST(SlotMapTest, Insert)
+{
+	slot_map<villager> target;
+	villager* value = new villager(0, 0);
+	handle value_handle = target.insert(value);
+
+	// The handle should refer to the inserted value
+	EXPECT_EQ(value, target.get(value_handle));
+	EXPECT_EQ(1u, target.size());
+}
+
+/**
+ * Tests whether the Slot Map detects handles to removed values
+ */
+TEST(SlotMapTest, EraseStaleHandle)
+{
+	slot_map<villager> target;
+	handle value_handle = target.insert(new villager(0, 0));
+
+	EXPECT_TRUE(target.erase(value_handle));
+
+	// The handle should no longer refer to a value, and cannot be removed twice
+	EXPECT_EQ(nullptr, target.get(value_handle));
+	EXPECT_FALSE(target.erase(value_handle));
+	EXPECT_TRUE(target.empty());
+}
+
+/**
+ * Tests whether the Slot Map reuses slots without reviving old handles
+ */
+TEST(SlotMapTest, ReuseSlot)
+{
+	slot_map<villager> target;
+	handle old_handle = target.insert(new villager(0, 0));
+	target.erase(old_handle);
+
+	villager* value = new villager(10, 10);
+	handle new_handle = target.insert(value);
+
+	// The slot should be reused with a new generation
+	EXPECT_EQ(old_handle.index, new_handle.index);
+	EXPECT_NE(old_handle.generation, new_handle.generation);
+	EXPECT_EQ(nullptr, target.get(old_handle));
+	EXPECT_EQ(value, target.get(new_handle));
+}
+
+/**
+ * Tests whether the Slot Map keeps values densely packed after a removal
+ */
+TEST(SlotMapTest, DenseAfterErase)
+{
+	slot_map<villager> target;
+	handle first = target.insert(new villager(0, 0));
+	handle second = target.insert(new villager(10, 10));
+	villager* last = new villager(20, 20);
+	handle third = target.insert(last);
+
+	target.erase(first);
+
+	// The last value should be moved into the gap, and its handle should still refer to it
+	EXPECT_EQ(2u, target.size());
+	EXPECT_EQ(last, target.at(0));
+	EXPECT_EQ(last, target.get(third));
+	EXPECT_NE(nullptr, target.get(second));
+
+	int count = 0;
+
+	for(slot_map<villager>::const_iterator iterator = target.begin(); iterator != target.end(); ++iterator)
+	{
+		EXPECT_NE(nullptr, iterator->get());
+		count += 1;
+	}
+
+	EXPECT_EQ(2, count);
+}
+
+/**
+ * Tests whether a default handle never refers to a value
+ */
+TEST(SlotMapTest, DefaultHandle)
+{
+	slot_map<villager> target;
+	target.insert(new villager(0, 0));
+
+	// Generation 0 is never used by the slot map
+	EXPECT_EQ(nullptr, target.get(handle{0, 0}));
+}
+
+/**
+ * Tests whether the Slot View iterates the values in the dense storage without copying them
+ */
+TEST(SlotMapTest, View)
+{
+	slot_map<villager> target;
+	villager* first = new villager(0, 0);
+	villager* second = new villager(10, 10);
+	target.insert(first);
+	target.insert(second);
+
+	slot_view<villager> view = target.get_view();
+
+	EXPECT_EQ(2u, view.size());
+	EXPECT_FALSE(view.empty());
+	EXPECT_EQ(first, view[0]);
+	EXPECT_EQ(second, view[1]);
+
+	int count = 0;
+
+	for(slot_view<villager>::iterator iterator = view.begin(); iterator != view.end(); ++iterator)
+	{
+		EXPECT_EQ(target.at(count), *iterator);
+		count += 1;
+	}
+
+	EXPECT_EQ(2, count);
+}
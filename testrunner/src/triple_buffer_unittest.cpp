@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include <thread>
+#include "triple_buffer.hpp"
+
+using namespace villa;
+
+/**
+ * Tests whether the Triple Buffer passes the newest published value to the reader
+ */
+TEST(TripleBufferTest, Latest)
+{
+	triple_buffer<int> target;
+
+	// Nothing has been published yet
+	EXPECT_FALSE(target.update());
+
+	target.get_back() = 1;
+	target.publish();
+	target.get_back() = 2;
+	target.publish();
+
+	// The first value was replaced before the reader took it
+	EXPECT_TRUE(target.update());
+	EXPECT_EQ(2, target.get_front());
+
+	// The front slot does not change until another value is published
+	EXPECT_FALSE(target.update());
+	EXPECT_EQ(2, target.get_front());
+
+	target.get_back() = 3;
+	target.publish();
+
+	EXPECT_EQ(2, target.get_front());
+	EXPECT_TRUE(target.update());
+	EXPECT_EQ(3, target.get_front());
+}
+
+/**
+ * Tests whether the Triple Buffer never lets the reader see a value while it is being written
+ */
+TEST(TripleBufferTest, Threads)
+{
+	triple_buffer<std::pair<int, int>> target;
+	const int count = 100000;
+
+	std::thread writer([&target, count]()
+	{
+		for(int i = 1; i <= count; ++i)
+		{
+			target.get_back().first = i;
+			target.get_back().second = -i;
+			target.publish();
+		}
+	});
+
+	int last = 0;
+
+	// Each value taken by the reader should be complete and newer than the last
+	while(last < count)
+	{
+		if(target.update())
+		{
+			EXPECT_EQ(-target.get_front().first, target.get_front().second);
+			EXPECT_GT(target.get_front().first, last);
+			last = target.get_front().first;
+		}
+	}
+
+	writer.join();
+}
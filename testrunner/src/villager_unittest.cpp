@@ -218,3 +218,49 @@ TEST(VillagerTest, GetTask)
 	// The villager should return the newly inserted task
 	EXPECT_EQ(target_task, target->get_task());
 }
+
+/**
+ * Tests whether the Villager's inventory finds items by id, and not an item that has replaced a taken one
+ */
+TEST(VillagerTest, FindItemById)
+{
+	std::unique_ptr<villager> target(new villager(0, 0));
+	inventory* inv = target->get_inventory();
+
+	inv->add_item(new item(itemtype::lumber));
+	unsigned long id = inv->get_items()[0]->get_id();
+
+	EXPECT_EQ(inv->get_items()[0], inv->find_item(id));
+
+	// Another item may be stored where the taken item was, but it has a new id
+	inv->remove_item(inv->find_item(id));
+	inv->add_item(new item(itemtype::lumber));
+
+	EXPECT_NE(id, inv->get_items()[0]->get_id());
+	EXPECT_EQ(nullptr, inv->find_item(id));
+	EXPECT_EQ(nullptr, inv->take_item(inv->find_item(id)).get());
+	EXPECT_EQ(1, inv->get_item_count());
+}
+
+/**
+ * Tests whether the Villager keeps its position from the start of the tick while it moves
+ */
+TEST(VillagerTest, PreviousPosition)
+{
+	std::unique_ptr<villager> target(new villager(16, 32));
+
+	EXPECT_EQ(16, target->get_previous_x());
+	EXPECT_EQ(32, target->get_previous_y());
+
+	target->store_position();
+	target->set_x(20);
+	target->set_y(40);
+
+	EXPECT_EQ(16, target->get_previous_x());
+	EXPECT_EQ(32, target->get_previous_y());
+
+	target->store_position();
+
+	EXPECT_EQ(20, target->get_previous_x());
+	EXPECT_EQ(40, target->get_previous_y());
+}